@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file bigint-bench.cxx
+ * @brief Throughput of every BigInt operation, 1 to 10^7 digits
+ *
+ * Each benchmark takes its operand size in decimal digits as the argument and
+ * reports, besides time per call, the rate at which limbs of the operands are
+ * processed ("limbs/s") and its inverse ("time/limb"), so that size classes
+ * can be compared directly. Built with SCH_ENABLE_STATS, they also report the
+ * limb allocations and bytes per iteration ("allocs/op", "bytes/op"); built
+ * with SCH_BENCH_PERF_COUNTERS on Linux, the cycles per limb, instructions per
+ * cycle, and cache and branch misses per iteration.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "BigInt.hpp"
+#include "perf-counters.hpp"
+#include "random.hpp"
+
+#ifndef SCH_BENCH_MAX_DIGITS
+#define SCH_BENCH_MAX_DIGITS 10000000
+#endif
+
+namespace {
+
+/// @return a string of `digits` random decimal digits, no leading zero
+std::string random_digits(const std::size_t digits, const std::uint64_t seed) {
+  std::mt19937_64 rng{seed};
+  std::string str(digits, '0');
+  str.front() = static_cast<char>('1' + rng() % 9);
+  for (std::size_t i = 1; i < digits; ++i) {
+    str[i] = static_cast<char>('0' + rng() % 10);
+  }
+  return str;
+}
+
+sch::BigInt random_big_int(const std::size_t digits, const std::uint64_t seed) {
+  std::mt19937_64 rng{seed};
+  return sch::random_digits(digits, rng);
+}
+
+/// @return the number of limbs a value of `digits` digits occupies
+std::int64_t limbs(const std::int64_t digits) {
+  constexpr auto EXP = static_cast<std::int64_t>(sch::BigInt::EXP);
+  return (digits + EXP - 1) / EXP;
+}
+
+/// the hardware counters of the benchmark thread, opened once
+sch::bench::PerfCounters &perf_counters() {
+  static sch::bench::PerfCounters counters;
+  return counters;
+}
+
+/**
+ * Samples what the build enables around one benchmark loop: allocations under
+ * SCH_ENABLE_STATS, hardware counters under SCH_BENCH_PERF_COUNTERS. Construct
+ * it right before the loop and report() right after.
+ */
+class Probe {
+public:
+  Probe() : _before{sch::stats()} { perf_counters().start(); }
+
+  /// attach the counters for `limb_count` limbs per iteration
+  void report(benchmark::State &state, const std::int64_t limb_count) {
+    const sch::bench::PerfSample perf = perf_counters().stop();
+    const auto iterations = static_cast<double>(state.iterations());
+    const auto processed = static_cast<double>(limb_count) * iterations;
+    state.counters["limbs/s"] =
+        benchmark::Counter(processed, benchmark::Counter::kIsRate);
+    state.counters["time/limb"] = benchmark::Counter(
+        processed, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+
+    if (perf_counters().available() && perf.cycles > 0) {
+      const auto cycles = static_cast<double>(perf.cycles);
+      state.counters["cycles/limb"] = cycles / processed;
+      state.counters["IPC"] = static_cast<double>(perf.instructions) / cycles;
+      state.counters["cache-miss/op"] =
+          static_cast<double>(perf.cache_misses) / iterations;
+      state.counters["branch-miss/op"] =
+          static_cast<double>(perf.branch_misses) / iterations;
+    }
+#ifdef SCH_ENABLE_STATS
+    const sch::OpStats total = (sch::stats() - _before).total();
+    state.counters["allocs/op"] =
+        static_cast<double>(total.allocations) / iterations;
+    state.counters["bytes/op"] = static_cast<double>(total.bytes) / iterations;
+#endif
+  }
+
+private:
+  sch::Stats _before;
+};
+
+/// sizes 1, 10, ..., SCH_BENCH_MAX_DIGITS
+void digit_sizes(benchmark::internal::Benchmark *b) {
+  for (std::int64_t digits = 1; digits <= SCH_BENCH_MAX_DIGITS; digits *= 10) {
+    b->Arg(digits);
+  }
+}
+
+// CONSTRUCTION AND CONVERSION -------------------------------------------------
+
+void BM_construct(benchmark::State &state) {
+  const std::string str = random_digits(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    sch::BigInt x{str};
+    benchmark::DoNotOptimize(x);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_to_string(benchmark::State &state) {
+  const sch::BigInt x = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    std::string str = x.to_string();
+    benchmark::DoNotOptimize(str);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+// COMPARISON ------------------------------------------------------------------
+
+void BM_compare(benchmark::State &state) {
+  // equal but for the lowest limb: the worst case
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  const sch::BigInt b = a + 1;
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a < b);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+// ARITHMETIC ------------------------------------------------------------------
+
+void BM_add(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  const sch::BigInt b = random_big_int(state.range(0), 2);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a + b);
+  }
+  probe.report(state, 2 * limbs(state.range(0)));
+}
+
+void BM_sub(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  const sch::BigInt b = random_big_int(state.range(0), 2);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a - b);
+  }
+  probe.report(state, 2 * limbs(state.range(0)));
+}
+
+void BM_mul(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  const sch::BigInt b = random_big_int(state.range(0), 2);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a * b);
+  }
+  probe.report(state, 2 * limbs(state.range(0)));
+}
+
+void BM_square(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a * a);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+/// 2n digits by n digits
+void BM_div(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(2 * state.range(0), 1);
+  const sch::BigInt b = random_big_int(state.range(0), 2);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a / b);
+  }
+  probe.report(state, 3 * limbs(state.range(0)));
+}
+
+/// 2n digits by n digits
+void BM_mod(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(2 * state.range(0), 1);
+  const sch::BigInt b = random_big_int(state.range(0), 2);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a % b);
+  }
+  probe.report(state, 3 * limbs(state.range(0)));
+}
+
+/// a 9-digit base to the power that gives an n-digit result
+void BM_pow(benchmark::State &state) {
+  const sch::BigInt base{987654321};
+  const std::int64_t exp = std::max<std::int64_t>(state.range(0) / 9, 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sch::pow(base, exp));
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+// TEMPLATED MIXED-TYPE OPERATORS ----------------------------------------------
+
+constexpr std::int64_t SMALL = 1'234'567'890'123'456'789;
+
+void BM_mixed_compare(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a == SMALL);
+    benchmark::DoNotOptimize(a < SMALL);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_mixed_add(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a + SMALL);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_mixed_sub(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SMALL - a);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_mixed_mul(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a * SMALL);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_mixed_div(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a / SMALL);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_mixed_mod(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a % SMALL);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+void BM_mixed_compound(benchmark::State &state) {
+  const sch::BigInt a = random_big_int(state.range(0), 1);
+  Probe probe;
+  for (auto _ : state) {
+    sch::BigInt x = a;
+    x += SMALL;
+    x *= 3;
+    x -= 7U;
+    benchmark::DoNotOptimize(x);
+  }
+  probe.report(state, limbs(state.range(0)));
+}
+
+} // namespace
+
+BENCHMARK(BM_construct)->Apply(digit_sizes);
+BENCHMARK(BM_to_string)->Apply(digit_sizes);
+BENCHMARK(BM_compare)->Apply(digit_sizes);
+BENCHMARK(BM_add)->Apply(digit_sizes);
+BENCHMARK(BM_sub)->Apply(digit_sizes);
+BENCHMARK(BM_mul)->Apply(digit_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_square)->Apply(digit_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_div)->Apply(digit_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_mod)->Apply(digit_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_pow)->Apply(digit_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_mixed_compare)->Apply(digit_sizes);
+BENCHMARK(BM_mixed_add)->Apply(digit_sizes);
+BENCHMARK(BM_mixed_sub)->Apply(digit_sizes);
+BENCHMARK(BM_mixed_mul)->Apply(digit_sizes);
+BENCHMARK(BM_mixed_div)->Apply(digit_sizes);
+BENCHMARK(BM_mixed_mod)->Apply(digit_sizes);
+BENCHMARK(BM_mixed_compound)->Apply(digit_sizes);
+
+// perf-regress links these benchmarks into its own main
+#ifndef SCH_BENCH_NO_MAIN
+BENCHMARK_MAIN();
+#endif
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file compare-bench.cxx
+ * @brief sch::BigInt against GMP's mpz_class and Boost's cpp_int
+ *
+ * Runs the same operations on the same inputs with every library that was
+ * found at configure time (SCH_HAVE_GMP, SCH_HAVE_BOOST), checks that all of
+ * them produce the same decimal result, and prints the time of each library
+ * and its ratio to sch, by operation and size.
+ *
+ * usage: compare-bench [max_digits = 1000000] [min_seconds = 0.2]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+
+#ifdef SCH_HAVE_GMP
+#include <gmpxx.h>
+#endif
+#ifdef SCH_HAVE_BOOST
+#include <boost/multiprecision/cpp_int.hpp>
+#endif
+
+namespace {
+
+// LIBRARY ADAPTERS ------------------------------------------------------------
+
+struct SchLib {
+  using Int = sch::BigInt;
+  static constexpr const char *NAME = "sch";
+  static Int from(const std::string &str) { return Int{str}; }
+  static std::string str(const Int &x) { return x.to_string(); }
+  static Int pow(const Int &base, const unsigned exp) {
+    return sch::pow(base, exp);
+  }
+};
+
+#ifdef SCH_HAVE_GMP
+struct GmpLib {
+  using Int = mpz_class;
+  static constexpr const char *NAME = "gmp";
+  static Int from(const std::string &str) { return Int{str}; }
+  static std::string str(const Int &x) { return x.get_str(); }
+  static Int pow(const Int &base, const unsigned exp) {
+    Int r;
+    mpz_pow_ui(r.get_mpz_t(), base.get_mpz_t(), exp);
+    return r;
+  }
+};
+#endif
+
+#ifdef SCH_HAVE_BOOST
+struct BoostLib {
+  using Int = boost::multiprecision::cpp_int;
+  static constexpr const char *NAME = "boost";
+  static Int from(const std::string &str) { return Int{str}; }
+  static std::string str(const Int &x) { return x.str(); }
+  static Int pow(const Int &base, const unsigned exp) {
+    return boost::multiprecision::pow(base, exp);
+  }
+};
+#endif
+
+// TIMING ----------------------------------------------------------------------
+
+/// keep the optimizer from discarding a result
+template <typename T> void escape(const T &x) {
+  asm volatile("" : : "g"(&x) : "memory");
+}
+
+/// @return the mean seconds per call of f, over at least min_seconds
+template <typename F> double time_per_call(F &&f, const double min_seconds) {
+  using Clock = std::chrono::steady_clock;
+  std::size_t calls = 0;
+  const auto start = Clock::now();
+  double elapsed = 0;
+  do {
+    f();
+    ++calls;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < min_seconds);
+  return elapsed / static_cast<double>(calls);
+}
+
+/// the inputs of one size class, as decimal strings
+struct Inputs {
+  std::string a;  ///< n digits
+  std::string b;  ///< n digits, negative
+  std::string a2; ///< 2n digits, the dividend
+  unsigned exp;   ///< 987654321^exp has about n digits
+};
+
+std::string random_digits(const std::size_t digits, std::mt19937_64 &rng) {
+  std::string str(digits, '0');
+  str.front() = static_cast<char>('1' + rng() % 9);
+  for (std::size_t i = 1; i < digits; ++i) {
+    str[i] = static_cast<char>('0' + rng() % 10);
+  }
+  return str;
+}
+
+/// one operation measured with one library
+struct Measurement {
+  double seconds;
+  std::string result;
+};
+
+using Operation = std::function<Measurement(const Inputs &, double)>;
+
+/// @return the named operations, measured with library L
+template <typename L> std::vector<std::pair<std::string, Operation>> ops() {
+  using Int = typename L::Int;
+  const auto binary = [](auto op) {
+    return [op](const Inputs &in, const double min_seconds) {
+      const Int a = L::from(in.a);
+      const Int b = L::from(in.b);
+      Int r = op(a, b);
+      const double t = time_per_call(
+          [&] {
+            r = op(a, b);
+            escape(r);
+          },
+          min_seconds);
+      return Measurement{t, L::str(r)};
+    };
+  };
+  const auto division = [](auto op) {
+    return [op](const Inputs &in, const double min_seconds) {
+      const Int a = L::from(in.a2);
+      const Int b = L::from(in.b);
+      Int r = op(a, b);
+      const double t = time_per_call(
+          [&] {
+            r = op(a, b);
+            escape(r);
+          },
+          min_seconds);
+      return Measurement{t, L::str(r)};
+    };
+  };
+
+  return {
+      {"construct",
+       [](const Inputs &in, const double min_seconds) {
+         Int r = L::from(in.a);
+         const double t = time_per_call(
+             [&] {
+               r = L::from(in.a);
+               escape(r);
+             },
+             min_seconds);
+         return Measurement{t, L::str(r)};
+       }},
+      {"to_string",
+       [](const Inputs &in, const double min_seconds) {
+         const Int a = L::from(in.a);
+         std::string r;
+         const double t = time_per_call(
+             [&] {
+               r = L::str(a);
+               escape(r);
+             },
+             min_seconds);
+         return Measurement{t, r};
+       }},
+      {"add", binary([](const Int &a, const Int &b) -> Int { return a + b; })},
+      {"sub", binary([](const Int &a, const Int &b) -> Int { return a - b; })},
+      {"mul", binary([](const Int &a, const Int &b) -> Int { return a * b; })},
+      {"div",
+       division([](const Int &a, const Int &b) -> Int { return a / b; })},
+      {"mod",
+       division([](const Int &a, const Int &b) -> Int { return a % b; })},
+      {"pow",
+       [](const Inputs &in, const double min_seconds) {
+         const Int base = L::from("987654321");
+         Int r = L::pow(base, in.exp);
+         const double t = time_per_call(
+             [&] {
+               r = L::pow(base, in.exp);
+               escape(r);
+             },
+             min_seconds);
+         return Measurement{t, L::str(r)};
+       }},
+  };
+}
+
+// REPORT ----------------------------------------------------------------------
+
+std::string format_seconds(const double s) {
+  std::ostringstream os;
+  os << std::setprecision(3);
+  if (s < 1e-6) {
+    os << s * 1e9 << " ns";
+  } else if (s < 1e-3) {
+    os << s * 1e6 << " us";
+  } else if (s < 1) {
+    os << s * 1e3 << " ms";
+  } else {
+    os << s << " s";
+  }
+  return os.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t max_digits =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+  const double min_seconds = argc > 2 ? std::strtod(argv[2], nullptr) : 0.2;
+
+  std::vector<const char *> names{SchLib::NAME};
+  std::vector<std::vector<std::pair<std::string, Operation>>> libraries{
+      ops<SchLib>()};
+#ifdef SCH_HAVE_GMP
+  names.push_back(GmpLib::NAME);
+  libraries.push_back(ops<GmpLib>());
+#endif
+#ifdef SCH_HAVE_BOOST
+  names.push_back(BoostLib::NAME);
+  libraries.push_back(ops<BoostLib>());
+#endif
+
+  // header: times, then sch / other for every other library
+  std::cout << std::left << std::setw(10) << "op" << std::right
+            << std::setw(9) << "digits";
+  for (const auto *name : names) {
+    std::cout << std::setw(12) << name;
+  }
+  for (std::size_t l = 1; l < names.size(); ++l) {
+    std::cout << std::setw(12) << std::string{"sch/"} + names[l];
+  }
+  std::cout << "  check\n";
+
+  std::mt19937_64 rng{20250101};
+  bool all_equal = true;
+  for (std::size_t digits = 10; digits <= max_digits; digits *= 10) {
+    const Inputs in{random_digits(digits, rng),
+                    "-" + random_digits(digits, rng),
+                    random_digits(2 * digits, rng),
+                    static_cast<unsigned>(digits / 9 + 1)};
+
+    for (std::size_t op = 0; op < libraries.front().size(); ++op) {
+      std::vector<Measurement> results;
+      for (const auto &library : libraries) {
+        results.push_back(library[op].second(in, min_seconds));
+      }
+
+      bool equal = true;
+      for (const auto &r : results) {
+        equal = equal && r.result == results.front().result;
+      }
+      all_equal = all_equal && equal;
+
+      std::cout << std::left << std::setw(10) << libraries.front()[op].first
+                << std::right << std::setw(9) << digits;
+      for (const auto &r : results) {
+        std::cout << std::setw(12) << format_seconds(r.seconds);
+      }
+      for (std::size_t l = 1; l < results.size(); ++l) {
+        std::ostringstream ratio;
+        ratio << std::fixed << std::setprecision(2)
+              << results.front().seconds / results[l].seconds << 'x';
+        std::cout << std::setw(12) << ratio.str();
+      }
+      std::cout << (equal ? "  ok" : "  MISMATCH") << '\n';
+    }
+  }
+
+  if (!all_equal) {
+    std::cerr << "compare-bench: results differ between libraries\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
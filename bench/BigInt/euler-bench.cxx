@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file euler-bench.cxx
+ * @brief End-to-end workloads in the style of Project Euler, with their
+ *        known answers
+ *
+ * Each workload is timed as a whole, the way such programs combine
+ * construction, arithmetic and conversion, and its answer is checked once
+ * before timing; a wrong answer marks the benchmark as failed with an error
+ * instead of reporting a time.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string>
+
+#include "BigInt.hpp"
+#include "ModInt.hpp"
+
+namespace {
+
+using sch::BigInt;
+
+std::uint64_t digit_sum(const BigInt &n) {
+  std::uint64_t sum = 0;
+  for (const char ch : n.to_string()) {
+    sum += static_cast<std::uint64_t>(ch - '0');
+  }
+  return sum;
+}
+
+BigInt factorial(const unsigned n) {
+  BigInt f{1};
+  for (unsigned k = 2; k <= n; ++k) {
+    f *= k;
+  }
+  return f;
+}
+
+// WORKLOADS -------------------------------------------------------------------
+
+/// problem 16, scaled: the digit sum of 2^n
+std::string power_digit_sum(const unsigned n) {
+  return std::to_string(digit_sum(sch::pow(BigInt{2}, n)));
+}
+
+/// problem 20, scaled: the digit sum of n!
+std::string factorial_digit_sum(const unsigned n) {
+  return std::to_string(digit_sum(factorial(n)));
+}
+
+/// problem 25, scaled: the index of the first Fibonacci number of n digits
+std::string fibonacci_digits(const std::size_t n) {
+  BigInt a{1};
+  BigInt b{1};
+  std::size_t index = 2;
+  // compare against 10^(n-1) rather than converting every term
+  const BigInt bound = sch::pow(BigInt{10}, n - 1);
+  while (b < bound) {
+    BigInt next = a + b;
+    a = std::move(b);
+    b = std::move(next);
+    ++index;
+  }
+  return std::to_string(index);
+}
+
+/// problem 14, reduced: the start below n with the longest Collatz chain
+std::string collatz(const unsigned n) {
+  unsigned best_start = 1;
+  unsigned best_length = 1;
+  for (unsigned start = 1; start < n; ++start) {
+    BigInt x{start};
+    unsigned length = 1;
+    while (x != 1) {
+      x = x % 2 == 0 ? x / 2 : x * 3 + 1;
+      ++length;
+    }
+    if (length > best_length) {
+      best_length = length;
+      best_start = start;
+    }
+  }
+  return std::to_string(best_start);
+}
+
+/// problem 29: distinct terms a^b for 2 <= a, b <= 100
+std::string distinct_powers() {
+  std::set<BigInt> terms;
+  for (unsigned a = 2; a <= 100; ++a) {
+    BigInt p{a};
+    for (unsigned b = 2; b <= 100; ++b) {
+      p *= a;
+      terms.insert(p);
+    }
+  }
+  return std::to_string(terms.size());
+}
+
+/// problem 48: the last ten digits of 1^1 + 2^2 + ... + 1000^1000
+std::string self_powers() {
+  const sch::ModContext ctx{BigInt{10'000'000'000}};
+  BigInt sum{0};
+  for (unsigned k = 1; k <= 1000; ++k) {
+    sum = ctx.add(sum, ctx.pow(BigInt{k}, k));
+  }
+  return sum.to_string();
+}
+
+/// problem 56: the largest digit sum of a^b for a, b < 100
+std::string powerful_digit_sum() {
+  std::uint64_t best = 0;
+  for (unsigned a = 1; a < 100; ++a) {
+    BigInt p{1};
+    for (unsigned b = 1; b < 100; ++b) {
+      p *= a;
+      best = std::max(best, digit_sum(p));
+    }
+  }
+  return std::to_string(best);
+}
+
+/// problem 57: expansions of sqrt 2 whose numerator has more digits
+std::string square_root_convergents() {
+  BigInt num{3};
+  BigInt den{2};
+  unsigned count = 0;
+  for (unsigned i = 0; i < 1000; ++i) {
+    if (num.to_string().size() > den.to_string().size()) {
+      ++count;
+    }
+    BigInt next_num = num + den * 2;
+    den = num + den;
+    num = std::move(next_num);
+  }
+  return std::to_string(count);
+}
+
+/// problem 65: the digit sum of the numerator of the 100th convergent of e
+std::string e_convergent() {
+  BigInt h0{1};
+  BigInt h1{2};
+  for (unsigned k = 1; k < 100; ++k) {
+    const unsigned term = k % 3 == 2 ? 2 * (k / 3 + 1) : 1;
+    BigInt h2 = h1 * term + h0;
+    h0 = std::move(h1);
+    h1 = std::move(h2);
+  }
+  return std::to_string(digit_sum(h1));
+}
+
+/// problem 97: the last ten digits of 28433 * 2^7830457 + 1
+std::string large_non_mersenne_prime() {
+  const sch::ModContext ctx{BigInt{10'000'000'000}};
+  const BigInt p = ctx.pow(BigInt{2}, 7830457);
+  return ctx.add(ctx.mul(BigInt{28433}, p), BigInt{1}).to_string();
+}
+
+/// problem 188: the last eight digits of the power tower 1777^^1855
+std::string power_tower() {
+  // the order of 1777 modulo 10^8 divides 10^8, so every exponent may be
+  // reduced modulo 10^8 too
+  const sch::ModContext ctx{BigInt{100'000'000}};
+  BigInt tower{1};
+  for (unsigned k = 0; k < 1855; ++k) {
+    tower = ctx.pow(BigInt{1777}, tower);
+  }
+  return tower.to_string();
+}
+
+// HARNESS ---------------------------------------------------------------------
+
+template <typename F>
+void BM_workload(benchmark::State &state, F workload,
+                 const std::string &expected) {
+  const std::string answer = workload();
+  if (answer != expected) {
+    const std::string error = "answer " + answer + ", expected " + expected;
+    state.SkipWithError(error.c_str());
+    return;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(workload());
+  }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_workload, pe16_2_pow_1000,
+                  [] { return power_digit_sum(1000); }, "1366");
+BENCHMARK_CAPTURE(BM_workload, pe16_2_pow_100000,
+                  [] { return power_digit_sum(100000); }, "135178")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe20_100_factorial,
+                  [] { return factorial_digit_sum(100); }, "648");
+BENCHMARK_CAPTURE(BM_workload, pe20_10000_factorial,
+                  [] { return factorial_digit_sum(10000); }, "149346")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe25_fibonacci_1000_digits,
+                  [] { return fibonacci_digits(1000); }, "4782")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_workload, pe25_fibonacci_10000_digits,
+                  [] { return fibonacci_digits(10000); }, "47847")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe14_collatz_below_10000,
+                  [] { return collatz(10000); }, "6171")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe29_distinct_powers, distinct_powers, "9183")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe48_self_powers, self_powers, "9110846700")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe56_powerful_digit_sum, powerful_digit_sum,
+                  "972")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe57_square_root_convergents,
+                  square_root_convergents, "153")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_workload, pe65_e_convergent, e_convergent, "272");
+BENCHMARK_CAPTURE(BM_workload, pe97_non_mersenne_prime,
+                  large_non_mersenne_prime, "8739992577");
+BENCHMARK_CAPTURE(BM_workload, pe188_power_tower, power_tower, "95962097")
+    ->Unit(benchmark::kMillisecond);
+
+// perf-regress links these benchmarks into its own main
+#ifndef SCH_BENCH_NO_MAIN
+BENCHMARK_MAIN();
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file perf-counters.hpp
+ * @brief Hardware performance counters for the benchmarks, via
+ *        perf_event_open
+ *
+ * Counts cycles, instructions, cache misses and branch misses of the calling
+ * thread, in user space only, as one group so that all four cover the same
+ * interval. Built only when SCH_BENCH_PERF_COUNTERS is defined on Linux;
+ * elsewhere, or when the kernel refuses (see
+ * /proc/sys/kernel/perf_event_paranoid), available() is false and the
+ * benchmarks report time alone.
+ */
+
+#ifndef SCH_BENCH_PERF_COUNTERS_HPP_
+#define SCH_BENCH_PERF_COUNTERS_HPP_
+
+#include <array>
+#include <cstdint>
+
+#if defined(SCH_BENCH_PERF_COUNTERS) && defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SCH_BENCH_HAVE_PERF 1
+#endif
+
+namespace sch::bench {
+
+/// counts over one interval
+struct PerfSample {
+  std::uint64_t cycles{};
+  std::uint64_t instructions{};
+  std::uint64_t cache_misses{};
+  std::uint64_t branch_misses{};
+};
+
+class PerfCounters {
+public:
+  PerfCounters() {
+#ifdef SCH_BENCH_HAVE_PERF
+    constexpr std::array<std::uint64_t, EVENTS> configs{
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (std::size_t i = 0; i < EVENTS; ++i) {
+      perf_event_attr attr{};
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[i];
+      attr.disabled = i == 0 ? 1 : 0; // the group starts with its leader
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      _fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1,
+                                         i == 0 ? -1 : _fds[0], 0));
+      if (_fds[i] < 0) {
+        close_all();
+        return;
+      }
+    }
+#endif
+  }
+  ~PerfCounters() { close_all(); }
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  /// @return whether the counters could be opened
+  [[nodiscard]] bool available() const { return _fds[0] >= 0; }
+
+  void start() {
+#ifdef SCH_BENCH_HAVE_PERF
+    if (available()) {
+      ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  /// @return the counts since start()
+  PerfSample stop() {
+    PerfSample sample;
+#ifdef SCH_BENCH_HAVE_PERF
+    if (available()) {
+      ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+      std::array<std::uint64_t, EVENTS + 1> values{}; // count, then the events
+      if (read(_fds[0], values.data(), sizeof(values)) ==
+          static_cast<ssize_t>(sizeof(values))) {
+        sample = {values[1], values[2], values[3], values[4]};
+      }
+    }
+#endif
+    return sample;
+  }
+
+private:
+  static constexpr std::size_t EVENTS = 4;
+
+  void close_all() {
+#ifdef SCH_BENCH_HAVE_PERF
+    for (int &fd : _fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+      fd = -1;
+    }
+#endif
+  }
+
+  std::array<int, EVENTS> _fds{-1, -1, -1, -1};
+};
+
+} // namespace sch::bench
+
+#endif // SCH_BENCH_PERF_COUNTERS_HPP_
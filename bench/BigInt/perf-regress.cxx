@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file perf-regress.cxx
+ * @brief Per-machine baselines of bigint-bench, and a regression check
+ *        against them
+ *
+ * Runs the bigint-bench suite in-process with repetitions, keeps the real time
+ * per iteration of every repetition, and either records those samples as the
+ * baseline of this machine or compares them with it. A benchmark regresses
+ * when the 95% confidence interval of its slowdown (Welch's t on the two sets
+ * of repetitions) lies entirely above the threshold, so noise alone does not
+ * fail the check however small the threshold.
+ *
+ * usage:
+ *   perf-regress record <dir> [options] [benchmark flags]
+ *   perf-regress check <dir> [options] [benchmark flags]
+ *
+ * options:
+ *   --machine=NAME   baseline file <dir>/NAME.json (default: the host name)
+ *   --threshold=F    tolerated slowdown, as a fraction (default: 0.05)
+ *
+ * Benchmark flags such as --benchmark_filter and --benchmark_repetitions
+ * (default 10) are passed through. `check` exits with 1 if any benchmark
+ * regressed and with 2 on usage or baseline errors.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <cstdlib>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Samples = std::map<std::string, std::vector<double>>;
+
+// COLLECTION ------------------------------------------------------------------
+
+/// prints as usual and keeps the time per iteration of every repetition
+class SampleReporter : public benchmark::ConsoleReporter {
+public:
+  void ReportRuns(const std::vector<Run> &runs) override {
+    for (const auto &run : runs) {
+      if (run.run_type == Run::RT_Iteration && run.iterations > 0) {
+        _samples[run.benchmark_name()].push_back(
+            run.real_accumulated_time * 1e9 /
+            static_cast<double>(run.iterations));
+      }
+    }
+    ConsoleReporter::ReportRuns(runs);
+  }
+
+  [[nodiscard]] const Samples &samples() const { return _samples; }
+
+private:
+  Samples _samples;
+};
+
+std::string host_name() {
+#ifdef _WIN32
+  const char *name = std::getenv("COMPUTERNAME");
+  return name != nullptr ? name : "unknown";
+#else
+  char name[256] = {};
+  if (gethostname(name, sizeof(name) - 1) != 0) {
+    return "unknown";
+  }
+  return name;
+#endif
+}
+
+// BASELINE FILES --------------------------------------------------------------
+
+std::string quoted(const std::string &str) {
+  std::string out = "\"";
+  for (const char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      out += '\\';
+    }
+    out += ch;
+  }
+  return out + '"';
+}
+
+void write_baseline(const std::string &path, const std::string &machine,
+                    const Samples &samples) {
+  std::ofstream out{path};
+  if (!out) {
+    throw std::runtime_error("cannot write " + path);
+  }
+  const auto &cpu = benchmark::CPUInfo::Get();
+  out << std::setprecision(17) << "{\n"
+      << "  \"machine\": " << quoted(machine) << ",\n"
+      << "  \"num_cpus\": " << cpu.num_cpus << ",\n"
+      << "  \"cycles_per_second\": " << cpu.cycles_per_second << ",\n"
+      << "  \"benchmarks\": [";
+  bool first = true;
+  for (const auto &[name, times] : samples) {
+    out << (first ? "\n" : ",\n") << "    {\"name\": " << quoted(name)
+        << ", \"samples_ns\": [";
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      out << (i == 0 ? "" : ", ") << times[i];
+    }
+    out << "]}";
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+}
+
+/// reads back what write_baseline() wrote; other keys are skipped
+class BaselineParser {
+public:
+  explicit BaselineParser(std::string text) : _text{std::move(text)} {}
+
+  Samples parse() {
+    Samples samples;
+    expect('{');
+    while (!consume('}')) {
+      const std::string key = string();
+      expect(':');
+      if (key == "benchmarks") {
+        expect('[');
+        while (!consume(']')) {
+          benchmark_entry(samples);
+          consume(',');
+        }
+      } else {
+        skip_value();
+      }
+      consume(',');
+    }
+    return samples;
+  }
+
+private:
+  void benchmark_entry(Samples &samples) {
+    std::string name;
+    std::vector<double> times;
+    expect('{');
+    while (!consume('}')) {
+      const std::string key = string();
+      expect(':');
+      if (key == "name") {
+        name = string();
+      } else if (key == "samples_ns") {
+        expect('[');
+        while (!consume(']')) {
+          times.push_back(number());
+          consume(',');
+        }
+      } else {
+        skip_value();
+      }
+      consume(',');
+    }
+    samples[name] = std::move(times);
+  }
+
+  void skip_space() {
+    while (_pos < _text.size() &&
+           std::isspace(static_cast<unsigned char>(_text[_pos])) != 0) {
+      ++_pos;
+    }
+  }
+
+  bool consume(const char ch) {
+    skip_space();
+    if (_pos < _text.size() && _text[_pos] == ch) {
+      ++_pos;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(const char ch) {
+    if (!consume(ch)) {
+      throw std::runtime_error(std::string{"baseline: expected '"} + ch +
+                               "' at offset " + std::to_string(_pos));
+    }
+  }
+
+  std::string string() {
+    expect('"');
+    std::string str;
+    while (_pos < _text.size() && _text[_pos] != '"') {
+      if (_text[_pos] == '\\') {
+        ++_pos;
+      }
+      if (_pos < _text.size()) {
+        str += _text[_pos++];
+      }
+    }
+    expect('"');
+    return str;
+  }
+
+  double number() {
+    skip_space();
+    std::size_t used = 0;
+    const double value = std::stod(_text.substr(_pos, 32), &used);
+    _pos += used;
+    return value;
+  }
+
+  void skip_value() { // NOLINT recursion
+    skip_space();
+    if (_pos >= _text.size()) {
+      throw std::runtime_error("baseline: unexpected end");
+    }
+    if (_text[_pos] == '"') {
+      string();
+    } else if (consume('{')) {
+      while (!consume('}')) {
+        string();
+        expect(':');
+        skip_value();
+        consume(',');
+      }
+    } else if (consume('[')) {
+      while (!consume(']')) {
+        skip_value();
+        consume(',');
+      }
+    } else {
+      while (_pos < _text.size() && std::string{",}] \n\t\r"}.find(
+                                        _text[_pos]) == std::string::npos) {
+        ++_pos;
+      }
+    }
+  }
+
+  std::string _text;
+  std::size_t _pos = 0;
+};
+
+Samples read_baseline(const std::string &path) {
+  std::ifstream in{path};
+  if (!in) {
+    throw std::runtime_error("no baseline at " + path +
+                             "; run `perf-regress record` first");
+  }
+  std::ostringstream text;
+  text << in.rdbuf();
+  return BaselineParser{text.str()}.parse();
+}
+
+// STATISTICS ------------------------------------------------------------------
+
+struct Summary {
+  double mean;
+  double variance; ///< of the samples, n - 1 in the denominator
+  double n;
+};
+
+Summary summarize(const std::vector<double> &x) {
+  const auto n = static_cast<double>(x.size());
+  double mean = 0;
+  for (const double v : x) {
+    mean += v;
+  }
+  mean /= n;
+  double ss = 0;
+  for (const double v : x) {
+    ss += (v - mean) * (v - mean);
+  }
+  return {mean, x.size() > 1 ? ss / (n - 1) : 0, n};
+}
+
+/// @return the 97.5% quantile of Student's t with df degrees of freedom
+double t_quantile(const double df) {
+  constexpr double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447,
+                              2.365,  2.306, 2.262, 2.228, 2.201, 2.179,
+                              2.160,  2.145, 2.131, 2.120, 2.110, 2.101,
+                              2.093,  2.086, 2.080, 2.074, 2.069, 2.064,
+                              2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+  const auto i = static_cast<std::size_t>(std::max(df, 1.0));
+  return i <= std::size(table) ? table[i - 1] : 1.96;
+}
+
+/// the relative change of the mean, current / baseline - 1, with its 95% CI
+struct Change {
+  double estimate;
+  double low;
+  double high;
+};
+
+Change relative_change(const std::vector<double> &base,
+                       const std::vector<double> &cur) {
+  const Summary b = summarize(base);
+  const Summary c = summarize(cur);
+  const double vb = b.variance / b.n;
+  const double vc = c.variance / c.n;
+  const double se = std::sqrt(vb + vc);
+  // Welch-Satterthwaite degrees of freedom
+  const double df =
+      se == 0 ? 1e9
+              : (vb + vc) * (vb + vc) /
+                    (vb * vb / std::max(b.n - 1, 1.0) +
+                     vc * vc / std::max(c.n - 1, 1.0));
+  const double half = t_quantile(df) * se;
+  const double diff = c.mean - b.mean;
+  return {diff / b.mean, (diff - half) / b.mean, (diff + half) / b.mean};
+}
+
+std::string percent(const double x) {
+  std::ostringstream os;
+  os << std::showpos << std::fixed << std::setprecision(1) << 100 * x << '%';
+  return os.str();
+}
+
+/// @return the number of regressions
+int report(const Samples &base, const Samples &cur, const double threshold) {
+  std::size_t width = 9;
+  for (const auto &entry : cur) {
+    width = std::max(width, entry.first.size());
+  }
+  std::cout << '\n'
+            << std::left << std::setw(static_cast<int>(width) + 2)
+            << "benchmark" << std::right << std::setw(14) << "baseline ns"
+            << std::setw(14) << "current ns" << std::setw(10) << "change"
+            << std::setw(22) << "95% CI" << "  verdict\n";
+
+  int regressions = 0;
+  for (const auto &[name, times] : cur) {
+    std::cout << std::left << std::setw(static_cast<int>(width) + 2) << name
+              << std::right;
+    const auto it = base.find(name);
+    if (it == base.end() || it->second.empty()) {
+      std::cout << std::setw(14) << "-" << std::setw(14) << std::fixed
+                << std::setprecision(1) << summarize(times).mean
+                << "  new\n";
+      continue;
+    }
+    const Change change = relative_change(it->second, times);
+    const char *verdict = "ok";
+    if (change.low > threshold) {
+      verdict = "REGRESSED";
+      ++regressions;
+    } else if (change.high < -threshold) {
+      verdict = "improved";
+    }
+    std::cout << std::setw(14) << std::fixed << std::setprecision(1)
+              << summarize(it->second).mean << std::setw(14)
+              << summarize(times).mean << std::setw(10)
+              << percent(change.estimate) << std::setw(22)
+              << "[" + percent(change.low) + ", " + percent(change.high) + "]"
+              << "  " << verdict << '\n';
+  }
+  for (const auto &entry : base) {
+    if (cur.count(entry.first) == 0) {
+      std::cout << std::left << std::setw(static_cast<int>(width) + 2)
+                << entry.first << "  not run\n";
+    }
+  }
+  return regressions;
+}
+
+int usage() {
+  std::cerr << "usage: perf-regress (record|check) <dir> [--machine=NAME] "
+               "[--threshold=F] [benchmark flags]\n";
+  return 2;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    return usage();
+  }
+  const std::string mode = argv[1];
+  const std::string dir = argv[2];
+  if (mode != "record" && mode != "check") {
+    return usage();
+  }
+
+  std::string machine = host_name();
+  double threshold = 0.05;
+  std::string repetitions = "--benchmark_repetitions=10";
+  std::vector<char *> bench_args{argv[0], repetitions.data()};
+  for (int i = 3; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.rfind("--machine=", 0) == 0) {
+      machine = arg.substr(10);
+    } else if (arg.rfind("--threshold=", 0) == 0) {
+      threshold = std::strtod(arg.c_str() + 12, nullptr);
+    } else {
+      bench_args.push_back(argv[i]); // later flags override the default
+    }
+  }
+  const std::string path = dir + "/" + machine + ".json";
+
+  try {
+    Samples base;
+    if (mode == "check") {
+      base = read_baseline(path); // fail before the long run, not after
+    }
+
+    int bench_argc = static_cast<int>(bench_args.size());
+    benchmark::Initialize(&bench_argc, bench_args.data());
+    if (benchmark::ReportUnrecognizedArguments(bench_argc,
+                                               bench_args.data())) {
+      return usage();
+    }
+    SampleReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (mode == "record") {
+      write_baseline(path, machine, reporter.samples());
+      std::cout << "baseline written to " << path << '\n';
+      return EXIT_SUCCESS;
+    }
+    const int regressions = report(base, reporter.samples(), threshold);
+    std::cout << regressions << " regression(s) beyond "
+              << percent(threshold) << '\n';
+    return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const std::exception &e) {
+    std::cerr << "perf-regress: " << e.what() << '\n';
+    return 2;
+  }
+}
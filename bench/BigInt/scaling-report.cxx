@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file scaling-report.cxx
+ * @brief Empirical complexity exponents of the BigInt operations
+ *
+ * Times every operation on a geometric series of operand sizes, writes the
+ * measurements as CSV, and prints for each operation the exponent b of the
+ * least-squares fit t = a n^b on a log-log scale, over all sizes and over the
+ * upper half alone (where the asymptotic tier dominates), next to the
+ * exponent its algorithm should reach.
+ *
+ * usage: scaling-report [min_digits = 1000] [max_digits = 1000000]
+ *                       [factor = 2] [min_seconds = 0.1] [csv = scaling.csv]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+
+namespace {
+
+/// keep the optimizer from discarding a result
+template <typename T> void escape(const T &x) {
+  asm volatile("" : : "g"(&x) : "memory");
+}
+
+/// @return the mean seconds per call of f, over at least min_seconds
+template <typename F> double time_per_call(F &&f, const double min_seconds) {
+  using Clock = std::chrono::steady_clock;
+  std::size_t calls = 0;
+  const auto start = Clock::now();
+  double elapsed = 0;
+  do {
+    f();
+    ++calls;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < min_seconds);
+  return elapsed / static_cast<double>(calls);
+}
+
+std::string random_digits(const std::size_t digits, std::mt19937_64 &rng) {
+  std::string str(digits, '0');
+  str.front() = static_cast<char>('1' + rng() % 9);
+  for (std::size_t i = 1; i < digits; ++i) {
+    str[i] = static_cast<char>('0' + rng() % 10);
+  }
+  return str;
+}
+
+/// an operation, timed on operands of n digits
+struct Operation {
+  std::string name;
+  double expected; ///< the exponent of the algorithm that serves large n
+  std::function<double(std::size_t, double, std::mt19937_64 &)> time;
+};
+
+std::vector<Operation> operations() {
+  using sch::BigInt;
+  const auto binary = [](auto op) {
+    return [op](const std::size_t n, const double min_seconds,
+                std::mt19937_64 &rng) {
+      const BigInt a{random_digits(n, rng)};
+      const BigInt b{random_digits(n, rng)};
+      return time_per_call([&] { escape(op(a, b)); }, min_seconds);
+    };
+  };
+  const auto division = [](auto op) {
+    return [op](const std::size_t n, const double min_seconds,
+                std::mt19937_64 &rng) {
+      const BigInt a{random_digits(2 * n, rng)};
+      const BigInt b{random_digits(n, rng)};
+      return time_per_call([&] { escape(op(a, b)); }, min_seconds);
+    };
+  };
+  const double karatsuba = std::log2(3.0);
+
+  return {
+      {"construct", 1,
+       [](const std::size_t n, const double min_seconds,
+          std::mt19937_64 &rng) {
+         const std::string str = random_digits(n, rng);
+         return time_per_call([&] { escape(BigInt{str}); }, min_seconds);
+       }},
+      {"to_string", 1,
+       [](const std::size_t n, const double min_seconds,
+          std::mt19937_64 &rng) {
+         const BigInt a{random_digits(n, rng)};
+         return time_per_call([&] { escape(a.to_string()); }, min_seconds);
+       }},
+      {"add", 1,
+       binary([](const BigInt &a, const BigInt &b) { return a + b; })},
+      {"mul", karatsuba,
+       binary([](const BigInt &a, const BigInt &b) { return a * b; })},
+      {"square", karatsuba,
+       [](const std::size_t n, const double min_seconds,
+          std::mt19937_64 &rng) {
+         const BigInt a{random_digits(n, rng)};
+         return time_per_call([&] { escape(a * a); }, min_seconds);
+       }},
+      {"div", karatsuba,
+       division([](const BigInt &a, const BigInt &b) { return a / b; })},
+      {"mod", karatsuba,
+       division([](const BigInt &a, const BigInt &b) { return a % b; })},
+      {"isqrt", karatsuba,
+       [](const std::size_t n, const double min_seconds,
+          std::mt19937_64 &rng) {
+         const BigInt a{random_digits(2 * n, rng)};
+         return time_per_call([&] { escape(sch::isqrt(a)); }, min_seconds);
+       }},
+  };
+}
+
+/// the least-squares fit of log t = log a + b log n
+struct Fit {
+  double exponent;
+  double r2;
+};
+
+Fit fit(const std::vector<double> &n, const std::vector<double> &t,
+        const std::size_t first) {
+  const auto count = static_cast<double>(n.size() - first);
+  double sx = 0;
+  double sy = 0;
+  for (std::size_t i = first; i < n.size(); ++i) {
+    sx += std::log(n[i]);
+    sy += std::log(t[i]);
+  }
+  const double mx = sx / count;
+  const double my = sy / count;
+  double sxx = 0;
+  double sxy = 0;
+  double syy = 0;
+  for (std::size_t i = first; i < n.size(); ++i) {
+    const double dx = std::log(n[i]) - mx;
+    const double dy = std::log(t[i]) - my;
+    sxx += dx * dx;
+    sxy += dx * dy;
+    syy += dy * dy;
+  }
+  if (sxx == 0 || syy == 0) {
+    return {0, 0};
+  }
+  return {sxy / sxx, sxy * sxy / (sxx * syy)};
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t min_digits =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+  const std::size_t max_digits =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000;
+  const double factor = argc > 3 ? std::strtod(argv[3], nullptr) : 2;
+  const double min_seconds = argc > 4 ? std::strtod(argv[4], nullptr) : 0.1;
+  const std::string csv_path = argc > 5 ? argv[5] : "scaling.csv";
+  if (min_digits == 0 || max_digits < min_digits || factor <= 1) {
+    std::cerr << "usage: scaling-report [min_digits] [max_digits] [factor > 1] "
+                 "[min_seconds] [csv]\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::size_t> sizes;
+  for (double n = static_cast<double>(min_digits);
+       n <= static_cast<double>(max_digits); n *= factor) {
+    sizes.push_back(static_cast<std::size_t>(n));
+  }
+
+  std::ofstream csv{csv_path};
+  if (!csv) {
+    std::cerr << "scaling-report: cannot write " << csv_path << '\n';
+    return EXIT_FAILURE;
+  }
+  csv << "op,digits,limbs,seconds\n" << std::setprecision(9);
+
+  std::cout << std::left << std::setw(12) << "op" << std::right
+            << std::setw(10) << "expected" << std::setw(10) << "fit"
+            << std::setw(10) << "r^2" << std::setw(12) << "upper fit"
+            << std::setw(10) << "r^2" << '\n';
+
+  std::mt19937_64 rng{20250101};
+  for (const auto &op : operations()) {
+    std::vector<double> n;
+    std::vector<double> t;
+    for (const std::size_t digits : sizes) {
+      const double seconds = op.time(digits, min_seconds, rng);
+      const std::size_t limbs = (digits + sch::BigInt::EXP - 1) /
+                                static_cast<std::size_t>(sch::BigInt::EXP);
+      csv << op.name << ',' << digits << ',' << limbs << ',' << seconds
+          << '\n';
+      n.push_back(static_cast<double>(digits));
+      t.push_back(seconds);
+    }
+
+    const Fit all = fit(n, t, 0);
+    const Fit upper = fit(n, t, n.size() / 2);
+    std::cout << std::left << std::setw(12) << op.name << std::right
+              << std::fixed << std::setprecision(2) << std::setw(10)
+              << op.expected << std::setw(10) << all.exponent << std::setw(10)
+              << all.r2 << std::setw(12) << upper.exponent << std::setw(10)
+              << upper.r2 << '\n';
+  }
+  std::cout << "measurements written to " << csv_path << '\n';
+  return EXIT_SUCCESS;
+}
@@ -12,9 +12,15 @@
 #ifndef SCH_INCLUDE_BigInt_HPP_
 #define SCH_INCLUDE_BigInt_HPP_
 
+#include "budget.hpp"
+#include "limbs.hpp"
+#include "probes.hpp"
+#include "stats.hpp"
+
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
-#include <execution>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -30,17 +36,33 @@ enum class Sign : bool { negative, positive };
  */
 class BigInt {
 public:
-  BigInt() = default;
+  using Limbs = detail::Limbs;
+
+  BigInt() { detail::on_construct(); }
   BigInt(const std::string &str);
   BigInt(const char *cstr) : BigInt(std::string{cstr}) {}
   BigInt(const std::string_view strv) : BigInt(std::string{strv}) {}
   template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
   BigInt(const T val) : BigInt(std::to_string(val)) {} // NOLINT
-  BigInt(const std::vector<std::uint64_t> &v) : _digits{v} { normalize(); }
+  BigInt(const Limbs &v) : _digits{v} {
+    detail::on_construct();
+    normalize();
+  }
+  BigInt(Limbs &&v) : _digits{std::move(v)} {
+    detail::on_construct();
+    normalize();
+  }
   ~BigInt() = default;
 
-  BigInt(const BigInt &) = default;       // copy constructor
-  BigInt(BigInt &&) = default;            // move constructor
+  // copy constructor
+  BigInt(const BigInt &other) : _sign{other._sign}, _digits{other._digits} {
+    detail::on_construct();
+  }
+  // move constructor
+  BigInt(BigInt &&other) noexcept
+      : _sign{other._sign}, _digits{std::move(other._digits)} {
+    detail::on_construct();
+  }
   BigInt &operator=(BigInt &&) = default; // move assignment
 
   // Copy assignment
@@ -106,18 +128,25 @@ public:
   BigInt operator-() const &;
 
   friend std::ostream &operator<<(std::ostream &os, const BigInt &b);
+  friend void fma(BigInt &acc, const BigInt &a, const BigInt &b);
   void normalize();
   [[nodiscard]] std::string to_string() const;
 
-private:
+  /// @return the limbs of the magnitude, base 10^EXP, little endian order
+  [[nodiscard]] const Limbs &limbs() const { return _digits; }
+  [[nodiscard]] Sign sign() const { return _sign; }
+
   // constants
   static constexpr std::uint64_t EXP = 18; // 10^EXP
-  static constexpr std::uint64_t BASE = 1'000'000'000'000'000'000;
+  static constexpr std::uint64_t BASE = detail::LIMB_BASE;
+
+private:
+  // constants
   static constexpr std::uint64_t K_MAX_DIGIT = 4294967296; // sqrt(2^64)-1
 
   // private variables
   Sign _sign = Sign::positive;          ///< Sign of the number
-  std::vector<std::uint64_t> _digits{}; ///< @note little endian order
+  Limbs _digits{};                      ///< @note little endian order
 
   // ADDITION HELPERS ----------------------------------------
   static void add(std::size_t &it_lhs, const BigInt &lhs, std::size_t &it_rhs,
@@ -130,18 +159,17 @@ private:
                        const BigInt &rhs, BigInt &difference);
   static void s_carryDown(std::size_t &it, const BigInt &bint_8,
                           BigInt &difference);
-
-  // MULTIPLICATION -------------------------------------------
-  [[nodiscard]] static std::string_view abs(const std::string &str);
-  static BigInt karatsuba(std::string_view lhs, std::string_view rhs);
-
-  // DIVISION -------------------------------------------------
-  static BigInt abs(const BigInt &bint);
 };
 
 template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
 BigInt pow(const BigInt &base, T exp);
 
+BigInt divexact(const BigInt &lhs, const BigInt &rhs);
+
+BigInt isqrt(const BigInt &n);
+
+void fma(BigInt &acc, const BigInt &a, const BigInt &b);
+
 // TEMPLATED OPERATORS ---------------------------------------------------------
 
 template <typename T,
@@ -255,11 +283,17 @@ BigInt operator*(const T &val, const BigInt &rhs) {
 // CONSTRUCTOR -----------------------------------------------------------------
 
 inline BigInt::BigInt(const std::string &str) {
+  const detail::OpScope scope{Op::construct};
   int minusSignOffset = 0;  // to ignore negative Sign, if it exists
   if (str.front() == '-') { // check for Sign
     minusSignOffset = 1;
     _sign = Sign::negative;
   }
+  // the limbs the digits fill, the same at entry and return
+  SCH_PROBE_SCOPE(from_string, (str.size() - minusSignOffset + EXP - 1) / EXP,
+                  str.size());
+  detail::on_construct();
+  detail::check_parse(str.size() - minusSignOffset);
   // ensure there are no other non-numeric characters
   if (!std::all_of(str.begin() + minusSignOffset, str.end(), isdigit)) {
     throw std::invalid_argument(
@@ -346,19 +380,21 @@ inline bool BigInt::operator>=(const BigInt &rhs) const {
 // UNARY MINUS -----------------------------------------------------------------
 
 inline BigInt BigInt::operator-() && {
-  _sign = _sign == Sign::positive ? Sign::negative : Sign::positive;
+  if (!detail::is_zero(_digits)) { // zero stays positive
+    _sign = _sign == Sign::positive ? Sign::negative : Sign::positive;
+  }
   return std::move(*this);
 }
 
 inline BigInt BigInt::operator-() const & {
   BigInt tmp = *this;
-  tmp._sign = tmp._sign == Sign::positive ? Sign::negative : Sign::positive;
-  return tmp;
+  return -std::move(tmp);
 }
 
 // ADDITION --------------------------------------------------------------------
 
 inline BigInt BigInt::operator+(const BigInt &rhs) const { // NOLINT
+  const detail::OpScope scope{Op::add};
   // todo optimizations for adding to 0 or 1 and so on
   // Initially, addition and subtraction were implemented assuming two
   // non-negative integers. Sign handling was introduced afterward; the most
@@ -448,6 +484,7 @@ inline void BigInt::a_carryDown(std::size_t &it, const BigInt &bint_8,
 // is there a way to work around using copies to maintain constness?
 
 inline BigInt BigInt::operator-(const BigInt &rhs) const { // NOLINT
+  const detail::OpScope scope{Op::sub};
   // todo optimizations for subtracting to and from 0 or 1 and so on
   // Initially, addition and subtraction were implemented assuming two
   // non-negative integers. Sign handling was introduced afterward; the most
@@ -541,238 +578,58 @@ inline void BigInt::s_carryDown(std::size_t &it, const BigInt &bint_8,
 
 // MULTIPLICATION --------------------------------------------------------------
 
-inline std::string_view BigInt::abs(const std::string &str) {
-  if (str.front() == '-') {
-    return std::string_view{str}.substr(1);
-  }
-  return std::string_view{str};
-}
-
-inline BigInt BigInt::karatsuba(const std::string_view lhs, // NOLINT recursion
-                                const std::string_view rhs) {
-  if (std::all_of(lhs.begin(), lhs.end(),
-                  [](const char c) { return c == '0'; }) ||
-      std::all_of(rhs.begin(), rhs.end(),
-                  [](const char c) { return c == '0'; })) {
-    return BigInt{0};
-  }
-
-  if (lhs.size() < 10 && rhs.size() < 10) {
-    return std::stoull(std::string{lhs}) * std::stoull(std::string{rhs});
-  }
-
-  const std::size_t m = std::max(lhs.size(), rhs.size());
-  const std::size_t n = m / 2;
-  std::string_view a;
-  std::string_view b;
-  std::string_view c;
-  std::string_view d;
-  if (lhs.size() > n) {
-    a = lhs.substr(0, lhs.size() - n);
-    b = lhs.substr(lhs.size() - n);
-  } else {
-    a = "0";
-    b = lhs;
-  }
-  if (rhs.size() > n) {
-    c = rhs.substr(0, rhs.size() - n);
-    d = rhs.substr(rhs.size() - n);
-  } else {
-    c = "0";
-    d = rhs;
-  }
-  const BigInt ac = karatsuba(a, c);
-  const BigInt bd = karatsuba(b, d);
-  const BigInt sum_ad_bc = karatsuba((BigInt{a} + BigInt{b}).to_string(),
-                                     (BigInt{c} + BigInt{d}).to_string()) -
-                           ac - bd;
-  return BigInt{ac.to_string() + std::string(2 * n, '0')} +
-         BigInt{sum_ad_bc.to_string() + std::string(n, '0')} + bd;
-}
-
 inline BigInt BigInt::operator*(const BigInt &rhs) const {
-  if (*this == 0 || rhs == 0) {
+  const detail::OpScope scope{Op::mul};
+  SCH_PROBE_SCOPE(mul, _digits.size(), rhs._digits.size());
+  if (detail::is_zero(_digits) || detail::is_zero(rhs._digits)) {
     return 0;
   }
-  return _sign == rhs._sign
-             ? karatsuba(abs(this->to_string()), abs(rhs.to_string()))
-             : -karatsuba(abs(this->to_string()), abs(rhs.to_string()));
+  // squares take the cheaper kernel
+  const bool square = this == &rhs || _digits == rhs._digits;
+  detail::check_mul(_digits.size(), rhs._digits.size(), square);
+  BigInt product{square ? detail::sqr(_digits)
+                        : detail::mul(_digits, rhs._digits)};
+  product._sign = _sign == rhs._sign ? Sign::positive : Sign::negative;
+  return product;
 }
 
 // DIVISION --------------------------------------------------------------------
 
-// todo https://learn.microsoft.com/en-us/cpp/intrinsics/div128?view=msvc-170
-
-inline BigInt BigInt::abs(const BigInt &bint) {
-  return bint._sign == Sign::positive ? bint : -bint;
-}
-
 inline BigInt BigInt::operator/(const BigInt &rhs) const {
-  if (rhs == 0) {
+  const detail::OpScope scope{Op::div};
+  SCH_PROBE_SCOPE(div, _digits.size(), rhs._digits.size());
+  if (detail::is_zero(rhs._digits)) {
     throw std::runtime_error(
         "BigInt::operator/() : Division by zero is undefined");
   }
-  if (*this == 0) {
-    return 0;
-  }
-
-  BigInt A = abs(*this);
-  BigInt B = abs(rhs);
-
-  if (B > A) {
+  if (detail::is_zero(_digits)) {
     return 0;
   }
-
-  BigInt Q{};
-  __uint128_t q = 0;
-  BigInt tw_q{};
-
-  BigInt scale{1};
-  if (B._digits.back() < BASE / 2) {
-    scale = BASE / 2 / B._digits.back();
-    while (B._digits.back() * scale < BASE / 2) {
-      scale += 1;
-    }
-    A *= scale;
-    B *= scale;
-  }
-
-  const std::int64_t n = B._digits.size();
-  const std::int64_t m = A._digits.size() - n;
-
-  if (A >= B.to_string() + std::string(EXP * m, '0')) { // A >= BASE^m * B
-    Q._digits.push_back(1);
-    A -= B.to_string() + std::string(EXP * m, '0'); // A = A - BASE^m * B
-  } else {
-    Q._digits.push_back(0);
-  }
-
-  for (std::int64_t j = m - 1; j >= 0; --j) {
-    // create two-word numerator
-
-    // a_{n+j}*BASE + a_{n+j-1}
-    const __uint128_t numerator =
-        static_cast<__uint128_t>(A._digits[n + j]) * BASE +
-        A._digits[n + j - 1];
-
-    q = numerator / B._digits[n - 1];
-    q = q < static_cast<__uint128_t>(BASE - 1)
-            ? q
-            : static_cast<__uint128_t>(BASE - 1);
-
-    // construct BigInt from two words
-    tw_q = std::vector{static_cast<std::uint64_t>(q),
-                       static_cast<std::uint64_t>(q >> 64)};
-
-    // A -= q * BASE ^ j * BASE;
-    A -= (tw_q.to_string() + std::string(EXP * j, '0')) * B;
-
-    while (A < 0) {
-      q = q - 1;
-      A += (B.to_string() + std::string(EXP * j, '0'));
-    }
-
-    tw_q = std::vector{static_cast<std::uint64_t>(q),
-                       static_cast<std::uint64_t>(q >> 64)};
-    if (tw_q._digits.back() == 0) {
-      tw_q._digits.pop_back();
-    }
-    std::reverse(tw_q._digits.begin(), tw_q._digits.end());
-
-    for (const auto d : tw_q._digits) {
-      Q._digits.push_back(d);
-    }
-  }
-
-  _sign == rhs._sign ? Q._sign = Sign::positive : Q._sign = Sign::negative;
-  std::reverse(Q._digits.begin(), Q._digits.end());
-  Q.normalize();
-  return Q;
+  detail::check_div(_digits.size(), rhs._digits.size());
+  detail::Limbs q;
+  detail::Limbs r;
+  detail::divmod(_digits, rhs._digits, q, r);
+  BigInt quotient{std::move(q)};
+  return _sign == rhs._sign ? quotient : -std::move(quotient);
 }
 
 // MODULO ----------------------------------------------------------------------
 
 inline BigInt BigInt::operator%(const BigInt &rhs) const {
-  if (rhs == 0) {
+  const detail::OpScope scope{Op::mod};
+  SCH_PROBE_SCOPE(mod, _digits.size(), rhs._digits.size());
+  if (detail::is_zero(rhs._digits)) {
     return *this;
   }
-  if (*this == 0 || rhs == 1) {
+  if (detail::is_zero(_digits)) {
     return 0;
   }
-
-  BigInt A = abs(*this);
-  BigInt B = abs(rhs);
-
-  if (B > A) {
-    return *this;
-  }
-
-  BigInt Q{};
-  __uint128_t q = 0;
-  BigInt tw_q{};
-
-  BigInt scale{1};
-  if (B._digits.back() < BASE / 2) {
-    scale = BASE / 2 / B._digits.back();
-    while (B._digits.back() * scale < BASE / 2) {
-      scale += 1;
-    }
-    A *= scale;
-    B *= scale;
-  }
-
-  const std::int64_t n = B._digits.size();
-  const std::int64_t m = A._digits.size() - n;
-
-  if (A >= B.to_string() + std::string(EXP * m, '0')) { // A >= BASE^m * B
-    Q._digits.push_back(1);
-    A -= B.to_string() + std::string(EXP * m, '0'); // A = A - BASE^m * B
-  } else {
-    Q._digits.push_back(0);
-  }
-
-  for (std::int64_t j = m - 1; j >= 0; --j) {
-    // create two-word numerator
-
-    // a_{n+j}*BASE + a_{n+j-1}
-    const __uint128_t numerator =
-        static_cast<__uint128_t>(A._digits[n + j]) * BASE +
-        A._digits[n + j - 1];
-
-    q = numerator / B._digits[n - 1];
-    q = q < static_cast<__uint128_t>(BASE - 1)
-            ? q
-            : static_cast<__uint128_t>(BASE - 1);
-
-    // construct BigInt from two words
-    tw_q = std::vector{static_cast<std::uint64_t>(q),
-                       static_cast<std::uint64_t>(q >> 64)};
-
-    // A -= q * BASE ^ j * BASE;
-    A -= (tw_q.to_string() + std::string(EXP * j, '0')) * B;
-
-    while (A < 0) {
-      q = q - 1;
-      A += (B.to_string() + std::string(EXP * j, '0'));
-    }
-
-    tw_q = std::vector{static_cast<std::uint64_t>(q),
-                       static_cast<std::uint64_t>(q >> 64)};
-    if (tw_q._digits.back() == 0) {
-      tw_q._digits.pop_back();
-    }
-    std::reverse(tw_q._digits.begin(), tw_q._digits.end());
-
-    for (const auto d : tw_q._digits) {
-      Q._digits.push_back(d);
-    }
-  }
-
-  A /= scale;
-  if (A != 0) {
-    A._sign = this->_sign;
-  }
-  return A;
+  detail::check_div(_digits.size(), rhs._digits.size());
+  detail::Limbs q;
+  detail::Limbs r;
+  detail::divmod(_digits, rhs._digits, q, r);
+  BigInt remainder{std::move(r)};
+  return _sign == Sign::positive ? remainder : -std::move(remainder);
 }
 
 // MEMBER FUNCTIONS ------------------------------------------------------------
@@ -787,6 +644,8 @@ inline void BigInt::normalize() {
 }
 
 inline std::string BigInt::to_string() const {
+  const detail::OpScope scope{Op::to_string};
+  SCH_PROBE_SCOPE(to_string, _digits.size(), _digits.size() * EXP);
   std::string str{};
   if (_sign == Sign::negative) {
     str += "-";
@@ -822,6 +681,8 @@ inline std::ostream &operator<<(std::ostream &os, const BigInt &b) {
  * @throws std::invalid_argument if `exp` is negative.
  */
 template <typename T, typename> BigInt pow(const BigInt &base, const T exp) {
+  const detail::OpScope scope{Op::pow};
+  SCH_PROBE_SCOPE(pow, base.limbs().size(), exp);
   if (exp < 0) {
     throw std::invalid_argument("BigInt::pow() : negative exponent");
   }
@@ -831,6 +692,7 @@ template <typename T, typename> BigInt pow(const BigInt &base, const T exp) {
   if (base == 0) {
     return 0;
   }
+  detail::check_pow(base.limbs(), static_cast<std::uint64_t>(exp));
 
   BigInt m_base = base;                       // mutable copy
   auto m_exp = static_cast<std::size_t>(exp); // mutable copy
@@ -840,12 +702,189 @@ template <typename T, typename> BigInt pow(const BigInt &base, const T exp) {
     if (m_exp % 2 == 1) {
       res *= m_base;
     }
-    m_base *= m_base;
     m_exp /= 2;
+    if (m_exp > 0) { // the last square would go unused
+      m_base *= m_base;
+    }
   }
   return res;
 }
 
+/**
+ * @brief Exact division, for when the remainder is known to be zero.
+ *
+ * Divides from the least significant limb up (Jebelean's exact division):
+ * each quotient limb is one multiplication by the inverse of the divisor's low
+ * limb modulo BASE, with no trial quotients or corrections. Factors of 2 and 5
+ * are divided out first so that the low limb is invertible.
+ * @param lhs The dividend, a multiple of `rhs`.
+ * @param rhs The divisor.
+ * @return lhs / rhs; unspecified if `rhs` does not divide `lhs`.
+ * @throws std::runtime_error if `rhs` is zero.
+ */
+inline BigInt divexact(const BigInt &lhs, const BigInt &rhs) {
+  if (rhs == 0) {
+    throw std::runtime_error("sch::divexact() : Division by zero is undefined");
+  }
+  const std::size_t an = lhs.limbs().size();
+  const std::size_t dn = rhs.limbs().size();
+  if (detail::budget_active() && an >= dn) {
+    detail::check_work(static_cast<double>(an - dn + 1) *
+                       static_cast<double>(dn));
+  }
+  detail::Limbs a = lhs.limbs();
+  detail::Limbs d = rhs.limbs();
+  detail::trim(a);
+  detail::trim(d);
+
+  // whole zero limbs of the divisor are zero limbs of the dividend too
+  std::size_t zeros = 0;
+  while (d[zeros] == 0) {
+    ++zeros;
+  }
+  if (a.size() <= zeros) {
+    return 0;
+  }
+  a.erase(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(zeros));
+  d.erase(d.begin(), d.begin() + static_cast<std::ptrdiff_t>(zeros));
+
+  // make the low limb of the divisor coprime to BASE
+  for (std::uint64_t g = std::gcd(d.front(), BigInt::BASE); g != 1;
+       g = std::gcd(d.front(), BigInt::BASE)) {
+    detail::divmod_1(d.data(), d.data(), d.size(), g);
+    detail::divmod_1(a.data(), a.data(), a.size(), g);
+    detail::trim(d);
+    detail::trim(a);
+  }
+
+  detail::Limbs q;
+  if (d.size() == 1) {
+    q.resize(a.size());
+    detail::divmod_1(q.data(), a.data(), a.size(), d.front());
+  } else if (a.size() >= d.size()) {
+    const std::uint64_t d_inv = detail::inv_mod_base(d.front());
+    q.resize(a.size() - d.size() + 1);
+    for (std::size_t i = 0; i < q.size(); ++i) {
+      q[i] = detail::mul_mod_base(a[i], d_inv); // zeroes a[i] below
+      const std::size_t n = std::min(d.size(), a.size() - i);
+      const std::uint64_t borrow = detail::submul_1(&a[i], d.data(), n, q[i]);
+      detail::sub_1(&a[i + n], a.size() - i - n, borrow);
+    }
+  }
+  detail::trim(q);
+
+  const bool negative = lhs.sign() != rhs.sign() && !detail::is_zero(q);
+  BigInt quotient{std::move(q)};
+  return negative ? -std::move(quotient) : quotient;
+}
+
+/**
+ * @brief Integer square root.
+ *
+ * The root of n's top half gives an over-estimate with half the digits right,
+ * and Newton's iteration x' = (x + n / x) / 2 then doubles them; one or two
+ * steps are enough.
+ * @param n The radicand.
+ * @return floor(sqrt(n)).
+ * @throws std::invalid_argument if `n` is negative.
+ */
+inline BigInt isqrt(const BigInt &n) { // NOLINT recursion
+  if (n < 0) {
+    throw std::invalid_argument("sch::isqrt() : negative radicand");
+  }
+  const std::size_t size = n.limbs().size();
+  if (size <= 2) {
+    __uint128_t v = n.limbs().front();
+    if (size == 2) {
+      v += static_cast<__uint128_t>(n.limbs().back()) * BigInt::BASE;
+    }
+    auto x = static_cast<__uint128_t>(std::sqrt(static_cast<double>(v)));
+    while (x * x > v) {
+      --x;
+    }
+    while ((x + 1) * (x + 1) <= v) {
+      ++x;
+    }
+    return BigInt{detail::Limbs{
+        static_cast<std::uint64_t>(x % BigInt::BASE),
+        static_cast<std::uint64_t>(x / BigInt::BASE)}};
+  }
+
+  // sqrt(n) < (isqrt(n / BASE^2k) + 1) BASE^k, with the top half of n
+  const std::size_t k = std::max<std::size_t>(size / 4, 1);
+  const BigInt top{detail::shift_down(n.limbs(), 2 * k)};
+  BigInt x{detail::shift_up((isqrt(top) + 1).limbs(), k)};
+  while (true) {
+    BigInt y = (x + n / x) / 2;
+    if (y >= x) {
+      return x;
+    }
+    x = std::move(y);
+  }
+}
+
+/**
+ * @brief acc += a * b, in place.
+ *
+ * When the product has acc's sign and one operand is short, its rows are
+ * added straight into acc's limbs and the product is never formed; otherwise
+ * it is formed once and added to or subtracted from acc's limbs, with no
+ * temporary for the sum.
+ */
+inline void fma(BigInt &acc, const BigInt &a, const BigInt &b) {
+  const detail::OpScope scope{Op::mul};
+  SCH_PROBE_SCOPE(mul, a._digits.size(), b._digits.size());
+  if (detail::is_zero(a._digits) || detail::is_zero(b._digits)) {
+    return;
+  }
+  detail::check_mul(a._digits.size(), b._digits.size());
+  const Sign sign = a._sign == b._sign ? Sign::positive : Sign::negative;
+  detail::Limbs &r = acc._digits;
+  if (detail::is_zero(r) || &acc == &a || &acc == &b) {
+    acc = detail::is_zero(r) ? a * b : acc + a * b;
+    return;
+  }
+  const detail::Limbs &big = a._digits.size() >= b._digits.size()
+                                 ? a._digits
+                                 : b._digits;
+  const detail::Limbs &small = &big == &a._digits ? b._digits : a._digits;
+  const std::size_t n = big.size() + small.size();
+
+  if (sign == acc._sign) {
+    r.resize(std::max(r.size(), n) + 1, 0);
+    if (small.size() < detail::KARATSUBA_THRESHOLD) {
+      for (std::size_t j = 0; j < small.size(); ++j) {
+        const std::uint64_t carry =
+            detail::addmul_1(r.data() + j, big.data(), big.size(), small[j]);
+        detail::add_1(r.data() + j + big.size(),
+                      r.size() - j - big.size(), carry);
+      }
+    } else {
+      const detail::Limbs p = detail::mul(big, small);
+      detail::add_1(r.data() + p.size(), r.size() - p.size(),
+                    detail::add_n(r.data(), r.data(), p.data(), p.size()));
+    }
+    detail::trim(r);
+    return;
+  }
+
+  const detail::Limbs p = detail::mul(big, small);
+  if (detail::compare(r, p) >= 0) { // |acc| shrinks, the sign stays
+    detail::sub_1(r.data() + p.size(), r.size() - p.size(),
+                  detail::sub_n(r.data(), r.data(), p.data(), p.size()));
+  } else { // the product wins: acc = p - acc, with the product's sign
+    detail::Limbs d = p;
+    detail::sub_1(d.data() + r.size(), d.size() - r.size(),
+                  detail::sub_n(d.data(), d.data(), r.data(), r.size()));
+    r = std::move(d);
+    acc._sign = sign;
+  }
+  detail::trim(r);
+  if (detail::is_zero(r)) {
+    acc._sign = Sign::positive;
+  }
+}
+
 } // namespace sch
 
 #endif // SCH_INCLUDE_BigInt_HPP_
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file LimbBatch.hpp
+ * @brief Many small non-negative integers of N limbs, stored as a structure
+ *        of arrays and operated on together
+ *
+ * Limb j of every value sits in one contiguous column, so each kernel is a
+ * loop over the values of a column with no branches on the data, no
+ * allocation per value and nothing to dispatch. The loops over the values
+ * vectorize (4 to 8 values per instruction with AVX2 or AVX-512, e.g.
+ * -march=native) wherever the operation has a vector form: addition,
+ * subtraction and comparison; multiplication and reduction run the same
+ * branch-free loops on 64 x 64 -> 128-bit scalar products, which no x86 or
+ * ARM vector unit provides.
+ */
+
+#ifndef SCH_INCLUDE_LIMBBATCH_HPP_
+#define SCH_INCLUDE_LIMBBATCH_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace sch {
+
+/**
+ * @class LimbBatch
+ * @brief A batch of values in [0, BASE^N), one column per limb.
+ * @tparam N The limbs per value, 1 to 32 (18 to 576 decimal digits).
+ */
+template <std::size_t N> class LimbBatch {
+  static_assert(N >= 1 && N <= 32, "LimbBatch holds 1 to 32 limbs per value");
+
+public:
+  static constexpr std::size_t LIMBS = N;
+
+  LimbBatch() = default;
+  /// `size` zeros
+  explicit LimbBatch(const std::size_t size) { resize(size); }
+  /// @throws std::invalid_argument if a value is negative or too wide
+  LimbBatch(std::initializer_list<BigInt> values) {
+    reserve(values.size());
+    for (const BigInt &x : values) {
+      push_back(x);
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const { return _columns[0].size(); }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  void resize(const std::size_t size) {
+    for (auto &column : _columns) {
+      column.resize(size, 0);
+    }
+  }
+  void reserve(const std::size_t size) {
+    for (auto &column : _columns) {
+      column.reserve(size);
+    }
+  }
+
+  /// @throws std::invalid_argument if x is negative or needs more than N limbs
+  void push_back(const BigInt &x) {
+    check(x);
+    const std::size_t n = x.limbs().size();
+    for (std::size_t j = 0; j < N; ++j) {
+      _columns[j].push_back(j < n ? x.limbs()[j] : 0);
+    }
+  }
+
+  /// @throws std::invalid_argument if x is negative or needs more than N limbs
+  void set(const std::size_t i, const BigInt &x) {
+    check(x);
+    const std::size_t n = x.limbs().size();
+    for (std::size_t j = 0; j < N; ++j) {
+      _columns[j][i] = j < n ? x.limbs()[j] : 0;
+    }
+  }
+
+  /// @return value i
+  [[nodiscard]] BigInt get(const std::size_t i) const {
+    detail::Limbs v(N);
+    for (std::size_t j = 0; j < N; ++j) {
+      v[j] = _columns[j][i];
+    }
+    detail::trim(v);
+    return BigInt{std::move(v)};
+  }
+
+  /// @return limb j of every value
+  [[nodiscard]] std::uint64_t *column(const std::size_t j) {
+    return _columns[j].data();
+  }
+  [[nodiscard]] const std::uint64_t *column(const std::size_t j) const {
+    return _columns[j].data();
+  }
+
+private:
+  static void check(const BigInt &x) {
+    if (x < 0 || x.limbs().size() > N) {
+      throw std::invalid_argument(
+          "sch::LimbBatch : value negative or wider than the batch");
+    }
+  }
+
+  std::array<std::vector<std::uint64_t>, N> _columns;
+};
+
+namespace detail {
+
+/// values per pass: the carries of one pass stay in L1
+inline constexpr std::size_t BATCH_CHUNK = 256;
+
+template <std::size_t N, std::size_t M>
+void check_sizes(const LimbBatch<N> &a, const LimbBatch<M> &b,
+                 const char *what) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument(what);
+  }
+}
+
+/**
+ * Division of two-limb numbers by an invariant divisor through a precomputed
+ * reciprocal, as div_base() does for BASE.
+ */
+class Reciprocal {
+public:
+  explicit Reciprocal(const std::uint64_t d) {
+    while (((d << _shift) >> 63U) == 0) {
+      ++_shift;
+    }
+    _d = d << _shift;
+    _inv = static_cast<std::uint64_t>(~static_cast<__uint128_t>(0) / _d);
+  }
+
+  /**
+   * @param x requires x < d * 2^64
+   * @param[out] rem x % d
+   * @return x / d
+   */
+  std::uint64_t divide(const __uint128_t x, std::uint64_t &rem) const {
+    const __uint128_t u = x << _shift;
+    const auto u1 = static_cast<std::uint64_t>(u >> 64U);
+    const auto u0 = static_cast<std::uint64_t>(u);
+    __uint128_t q = static_cast<__uint128_t>(_inv) * u1;
+    q += u;
+    auto q1 = static_cast<std::uint64_t>(q >> 64U) + 1;
+    const auto q0 = static_cast<std::uint64_t>(q);
+    std::uint64_t r = u0 - q1 * _d;
+    if (r > q0) {
+      --q1;
+      r += _d;
+    }
+    if (r >= _d) {
+      ++q1;
+      r -= _d;
+    }
+    rem = r >> _shift;
+    return q1;
+  }
+
+private:
+  std::uint64_t _d = 0;
+  std::uint64_t _inv = 0;
+  unsigned _shift = 0;
+};
+
+} // namespace detail
+
+/// @return (a + b) mod BASE^N, value by value
+template <std::size_t N>
+LimbBatch<N> operator+(const LimbBatch<N> &a, const LimbBatch<N> &b) {
+  detail::check_sizes(a, b, "sch::LimbBatch::operator+() : size mismatch");
+  LimbBatch<N> r(a.size());
+  std::array<std::uint64_t, detail::BATCH_CHUNK> carry{};
+  for (std::size_t first = 0; first < a.size();
+       first += detail::BATCH_CHUNK) {
+    const std::size_t n = std::min(detail::BATCH_CHUNK, a.size() - first);
+    std::fill(carry.begin(), carry.end(), 0);
+    for (std::size_t j = 0; j < N; ++j) {
+      const std::uint64_t *const x = a.column(j) + first;
+      const std::uint64_t *const y = b.column(j) + first;
+      std::uint64_t *const z = r.column(j) + first;
+      for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t s = x[i] + y[i] + carry[i];
+        carry[i] = s >= detail::LIMB_BASE ? 1 : 0;
+        z[i] = s - carry[i] * detail::LIMB_BASE;
+      }
+    }
+  }
+  return r;
+}
+
+/// @return (a - b) mod BASE^N, value by value
+template <std::size_t N>
+LimbBatch<N> operator-(const LimbBatch<N> &a, const LimbBatch<N> &b) {
+  detail::check_sizes(a, b, "sch::LimbBatch::operator-() : size mismatch");
+  LimbBatch<N> r(a.size());
+  std::array<std::uint64_t, detail::BATCH_CHUNK> borrow{};
+  for (std::size_t first = 0; first < a.size();
+       first += detail::BATCH_CHUNK) {
+    const std::size_t n = std::min(detail::BATCH_CHUNK, a.size() - first);
+    std::fill(borrow.begin(), borrow.end(), 0);
+    for (std::size_t j = 0; j < N; ++j) {
+      const std::uint64_t *const x = a.column(j) + first;
+      const std::uint64_t *const y = b.column(j) + first;
+      std::uint64_t *const z = r.column(j) + first;
+      for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t d = y[i] + borrow[i];
+        borrow[i] = x[i] < d ? 1 : 0;
+        z[i] = x[i] + borrow[i] * detail::LIMB_BASE - d;
+      }
+    }
+  }
+  return r;
+}
+
+/// @return the full products a * b, value by value, for N up to 16
+template <std::size_t N>
+LimbBatch<2 * N> operator*(const LimbBatch<N> &a, const LimbBatch<N> &b) {
+  static_assert(N <= 16, "LimbBatch products have at most 32 limbs");
+  detail::check_sizes(a, b, "sch::LimbBatch::operator*() : size mismatch");
+  LimbBatch<2 * N> r(a.size());
+  std::array<__uint128_t, detail::BATCH_CHUNK> column{};
+  std::array<std::uint64_t, detail::BATCH_CHUNK> carry{};
+  for (std::size_t first = 0; first < a.size();
+       first += detail::BATCH_CHUNK) {
+    const std::size_t n = std::min(detail::BATCH_CHUNK, a.size() - first);
+    std::fill(carry.begin(), carry.end(), 0);
+    // column by column: the N partial products of a column, at most
+    // 16 (BASE - 1)^2, are summed in 128 bits and reduced once
+    for (std::size_t k = 0; k < 2 * N - 1; ++k) {
+      std::copy(carry.begin(), carry.end(), column.begin());
+      for (std::size_t j = k < N ? 0 : k - N + 1; j <= std::min(k, N - 1);
+           ++j) {
+        const std::uint64_t *const x = a.column(j) + first;
+        const std::uint64_t *const y = b.column(k - j) + first;
+        for (std::size_t i = 0; i < n; ++i) {
+          column[i] += static_cast<__uint128_t>(x[i]) * y[i];
+        }
+      }
+      std::uint64_t *const z = r.column(k) + first;
+      for (std::size_t i = 0; i < n; ++i) {
+        carry[i] = detail::div_base(column[i], z[i]);
+      }
+    }
+    std::copy(carry.begin(), carry.begin() + static_cast<std::ptrdiff_t>(n),
+              r.column(2 * N - 1) + first);
+  }
+  return r;
+}
+
+/**
+ * @return a mod m, value by value, for a common modulus m
+ * @throws std::invalid_argument if m is not positive or is wider than N limbs
+ */
+template <std::size_t N>
+LimbBatch<N> operator%(const LimbBatch<N> &a, const BigInt &m) {
+  if (m <= 0 || m.limbs().size() > N) {
+    throw std::invalid_argument(
+        "sch::LimbBatch::operator%() : modulus not positive or too wide");
+  }
+  const std::size_t mn = m.limbs().size();
+  LimbBatch<N> r(a.size());
+  if (mn == 1) { // a single limb: one remainder chain per value
+    const detail::Reciprocal d{m.limbs()[0]};
+    for (std::size_t j = N; j-- > 0;) {
+      const std::uint64_t *const x = a.column(j);
+      std::uint64_t *const z = r.column(0); // the running remainder
+      for (std::size_t i = 0; i < a.size(); ++i) {
+        d.divide(static_cast<__uint128_t>(z[i]) * detail::LIMB_BASE + x[i],
+                 z[i]);
+      }
+    }
+    return r;
+  }
+
+  // Knuth's algorithm D on every value at once, the divisor normalized so
+  // that each estimated quotient limb is at most 2 too large
+  const std::uint64_t scale = detail::LIMB_BASE / (m.limbs().back() + 1);
+  std::array<std::uint64_t, N> v{};
+  detail::mul_1(v.data(), m.limbs().data(), mn, scale);
+  const detail::Reciprocal v1{v[mn - 1]};
+  const detail::Reciprocal unscale{scale};
+
+  std::array<std::array<std::uint64_t, detail::BATCH_CHUNK>, N + 1> u{};
+  std::array<std::uint64_t, detail::BATCH_CHUNK> q{};
+  std::array<std::uint64_t, detail::BATCH_CHUNK> borrow{};
+  for (std::size_t first = 0; first < a.size();
+       first += detail::BATCH_CHUNK) {
+    const std::size_t n = std::min(detail::BATCH_CHUNK, a.size() - first);
+
+    // u = a * scale, one limb longer
+    std::fill(borrow.begin(), borrow.end(), 0); // the carry, here
+    for (std::size_t j = 0; j < N; ++j) {
+      const std::uint64_t *const x = a.column(j) + first;
+      for (std::size_t i = 0; i < n; ++i) {
+        borrow[i] = detail::div_base(
+            static_cast<__uint128_t>(x[i]) * scale + borrow[i], u[j][i]);
+      }
+    }
+    std::copy(borrow.begin(), borrow.end(), u[N].begin());
+
+    for (std::size_t j = N - mn + 1; j-- > 0;) {
+      // estimate, then subtract q v from u[j..j+mn]
+      for (std::size_t i = 0; i < n; ++i) {
+        const __uint128_t top =
+            static_cast<__uint128_t>(u[j + mn][i]) * detail::LIMB_BASE +
+            u[j + mn - 1][i];
+        std::uint64_t rem = 0;
+        q[i] = std::min(v1.divide(top, rem), detail::LIMB_BASE - 1);
+        borrow[i] = 0;
+      }
+      for (std::size_t k = 0; k < mn; ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+          std::uint64_t lo = 0;
+          const std::uint64_t hi = detail::div_base(
+              static_cast<__uint128_t>(q[i]) * v[k] + borrow[i], lo);
+          const std::uint64_t under = u[j + k][i] < lo ? 1 : 0;
+          u[j + k][i] = u[j + k][i] + under * detail::LIMB_BASE - lo;
+          borrow[i] = hi + under;
+        }
+      }
+      // the top limb goes "negative" (wraps) when q was too large: add v back
+      // until it does not, at most twice
+      for (int pass = 0; pass < 2; ++pass) {
+        for (std::size_t i = 0; i < n; ++i) {
+          const std::uint64_t add = u[j + mn][i] < borrow[i] ? 1 : 0;
+          std::uint64_t carry = 0;
+          for (std::size_t k = 0; k < mn; ++k) {
+            const std::uint64_t s = u[j + k][i] + add * v[k] + carry;
+            carry = s >= detail::LIMB_BASE ? 1 : 0;
+            u[j + k][i] = s - carry * detail::LIMB_BASE;
+          }
+          borrow[i] -= add * carry;
+        }
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        u[j + mn][i] -= borrow[i];
+      }
+    }
+
+    // r = u[0..mn) / scale
+    std::fill(borrow.begin(), borrow.end(), 0); // the remainder, here
+    for (std::size_t k = mn; k-- > 0;) {
+      std::uint64_t *const z = r.column(k) + first;
+      for (std::size_t i = 0; i < n; ++i) {
+        z[i] = unscale.divide(
+            static_cast<__uint128_t>(borrow[i]) * detail::LIMB_BASE + u[k][i],
+            borrow[i]);
+      }
+    }
+  }
+  return r;
+}
+
+/**
+ * @return for each value, -1, 0 or 1 as a[i] is less than, equal to or
+ *         greater than b[i]
+ */
+template <std::size_t N>
+std::vector<int> compare(const LimbBatch<N> &a, const LimbBatch<N> &b) {
+  detail::check_sizes(a, b, "sch::compare() : LimbBatch size mismatch");
+  std::vector<int> r(a.size(), 0);
+  for (std::size_t j = N; j-- > 0;) { // the top limb that differs decides
+    const std::uint64_t *const x = a.column(j);
+    const std::uint64_t *const y = b.column(j);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      const int c =
+          static_cast<int>(x[i] > y[i]) - static_cast<int>(x[i] < y[i]);
+      r[i] = r[i] != 0 ? r[i] : c;
+    }
+  }
+  return r;
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_LIMBBATCH_HPP_
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file Matrix.hpp
+ * @brief Dense matrices with exact, fraction-free elimination
+ */
+
+#ifndef SCH_INCLUDE_MATRIX_HPP_
+#define SCH_INCLUDE_MATRIX_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sch {
+
+namespace detail {
+
+/**
+ * One Bareiss update, (akk * aij - aik * akj) / prev. The division is exact
+ * by Sylvester's identity.
+ */
+template <typename T>
+T bareiss_update(const T &akk, const T &aij, const T &aik, const T &akj,
+                 const T &prev) {
+  return (akk * aij - aik * akj) / prev;
+}
+
+/// BigInt overload: products on the limbs, then exact division
+inline BigInt bareiss_update(const BigInt &akk, const BigInt &aij,
+                             const BigInt &aik, const BigInt &akj,
+                             const BigInt &prev) {
+  Limbs p = mul(akk.limbs(), aij.limbs());
+  Limbs q = mul(aik.limbs(), akj.limbs());
+  const bool p_neg = akk.sign() != aij.sign();
+  const bool q_neg = aik.sign() != akj.sign();
+
+  // p - q, as a magnitude and a sign
+  Limbs t;
+  bool t_neg = p_neg;
+  if (p_neg != q_neg) {
+    t = add(p, q);
+  } else if (compare(p, q) >= 0) {
+    t = sub(p, q);
+  } else {
+    t = sub(q, p);
+    t_neg = !p_neg;
+  }
+  t_neg = t_neg && !is_zero(t);
+
+  BigInt numerator{std::move(t)};
+  return divexact(t_neg ? -std::move(numerator) : numerator, prev);
+}
+
+template <typename T> [[nodiscard]] bool is_zero_entry(const T &x) {
+  return x == T{0};
+}
+
+[[nodiscard]] inline bool is_zero_entry(const BigInt &x) {
+  return is_zero(x.limbs());
+}
+
+/// acc += a * b
+template <typename T> void add_product(T &acc, const T &a, const T &b) {
+  acc += a * b;
+}
+
+/// BigInt overload: accumulates in place, without a temporary product
+inline void add_product(BigInt &acc, const BigInt &a, const BigInt &b) {
+  fma(acc, a, b);
+}
+
+} // namespace detail
+
+/**
+ * @class Matrix
+ * @brief Dense, row-major matrix
+ * @tparam T the entry type, normally BigInt
+ *
+ * determinant(), rank() and solve() use Bareiss' fraction-free elimination:
+ * every intermediate entry is a minor of the input, so entries stay integral
+ * and grow only linearly, and each step divides exactly by the previous pivot
+ * (divexact() for BigInt). The row updates of a pivot step are independent
+ * and run in parallel, on as many threads as the ExecutionPolicy allows.
+ */
+template <typename T> class Matrix {
+public:
+  /// the solution of A x = b, x_i = numerators[i] / denominator
+  struct Solution {
+    std::vector<T> numerators;
+    T denominator;
+  };
+
+  Matrix() = default;
+  Matrix(std::size_t rows, std::size_t cols);
+  Matrix(std::initializer_list<std::initializer_list<T>> init);
+
+  [[nodiscard]] static Matrix identity(std::size_t n);
+
+  [[nodiscard]] std::size_t rows() const { return _rows; }
+  [[nodiscard]] std::size_t cols() const { return _cols; }
+
+  T &operator()(const std::size_t i, const std::size_t j) {
+    return _data[i * _cols + j];
+  }
+  const T &operator()(const std::size_t i, const std::size_t j) const {
+    return _data[i * _cols + j];
+  }
+
+  bool operator==(const Matrix &rhs) const;
+  bool operator!=(const Matrix &rhs) const { return !(*this == rhs); }
+
+  Matrix operator+(const Matrix &rhs) const;
+  Matrix operator-(const Matrix &rhs) const;
+  Matrix operator*(const Matrix &rhs) const;
+
+  /// @throws std::invalid_argument if the matrix is not square
+  [[nodiscard]] T determinant(ExecutionPolicy policy = par) const;
+  [[nodiscard]] std::size_t rank(ExecutionPolicy policy = par) const;
+  /**
+   * @param b the right-hand side, one entry per row
+   * @throws std::invalid_argument if the matrix is not square or `b` has the
+   *         wrong size
+   * @throws std::runtime_error if the matrix is singular
+   */
+  [[nodiscard]] Solution solve(const std::vector<T> &b,
+                               ExecutionPolicy policy = par) const;
+
+private:
+  std::size_t _rows{};
+  std::size_t _cols{};
+  std::vector<T> _data{}; ///< @note row-major order
+
+  /// result of a forward elimination
+  struct Echelon {
+    std::size_t rank{};
+    bool negate{}; ///< an odd number of row swaps
+    T last_pivot{1};
+  };
+
+  Echelon eliminate(std::size_t pivot_cols, bool jordan,
+                    ExecutionPolicy policy);
+  void swap_rows(std::size_t r1, std::size_t r2);
+};
+
+// CONSTRUCTORS ----------------------------------------------------------------
+
+template <typename T>
+Matrix<T>::Matrix(const std::size_t rows, const std::size_t cols)
+    : _rows{rows}, _cols{cols}, _data(rows * cols, T{0}) {}
+
+template <typename T>
+Matrix<T>::Matrix(const std::initializer_list<std::initializer_list<T>> init)
+    : _rows{init.size()}, _cols{init.size() == 0 ? 0 : init.begin()->size()} {
+  _data.reserve(_rows * _cols);
+  for (const auto &row : init) {
+    if (row.size() != _cols) {
+      throw std::invalid_argument("Matrix::Matrix() : ragged initializer");
+    }
+    _data.insert(_data.end(), row.begin(), row.end());
+  }
+}
+
+template <typename T> Matrix<T> Matrix<T>::identity(const std::size_t n) {
+  Matrix m{n, n};
+  for (std::size_t i = 0; i < n; ++i) {
+    m(i, i) = T{1};
+  }
+  return m;
+}
+
+// ARITHMETIC OPERATORS --------------------------------------------------------
+
+template <typename T> bool Matrix<T>::operator==(const Matrix &rhs) const {
+  return _rows == rhs._rows && _cols == rhs._cols && _data == rhs._data;
+}
+
+template <typename T> Matrix<T> Matrix<T>::operator+(const Matrix &rhs) const {
+  if (_rows != rhs._rows || _cols != rhs._cols) {
+    throw std::invalid_argument("Matrix::operator+() : dimension mismatch");
+  }
+  Matrix sum{*this};
+  for (std::size_t i = 0; i < _data.size(); ++i) {
+    sum._data[i] = _data[i] + rhs._data[i];
+  }
+  return sum;
+}
+
+template <typename T> Matrix<T> Matrix<T>::operator-(const Matrix &rhs) const {
+  if (_rows != rhs._rows || _cols != rhs._cols) {
+    throw std::invalid_argument("Matrix::operator-() : dimension mismatch");
+  }
+  Matrix difference{*this};
+  for (std::size_t i = 0; i < _data.size(); ++i) {
+    difference._data[i] = _data[i] - rhs._data[i];
+  }
+  return difference;
+}
+
+template <typename T> Matrix<T> Matrix<T>::operator*(const Matrix &rhs) const {
+  if (_cols != rhs._rows) {
+    throw std::invalid_argument("Matrix::operator*() : dimension mismatch");
+  }
+  Matrix product{_rows, rhs._cols};
+  for (std::size_t i = 0; i < _rows; ++i) {
+    for (std::size_t k = 0; k < _cols; ++k) {
+      if (detail::is_zero_entry((*this)(i, k))) {
+        continue;
+      }
+      for (std::size_t j = 0; j < rhs._cols; ++j) {
+        detail::add_product(product(i, j), (*this)(i, k), rhs(k, j));
+      }
+    }
+  }
+  return product;
+}
+
+// ELIMINATION -----------------------------------------------------------------
+
+template <typename T>
+void Matrix<T>::swap_rows(const std::size_t r1, const std::size_t r2) {
+  const auto first = _data.begin() + static_cast<std::ptrdiff_t>(r1 * _cols);
+  std::swap_ranges(first, first + static_cast<std::ptrdiff_t>(_cols),
+                   _data.begin() + static_cast<std::ptrdiff_t>(r2 * _cols));
+}
+
+/**
+ * @brief Bareiss fraction-free elimination, in place.
+ * @param pivot_cols only the first pivot_cols columns are searched for pivots;
+ *        the rest (an augmented right-hand side) are carried along
+ * @param jordan also eliminate above each pivot (fraction-free Gauss-Jordan),
+ *        leaving every pivot equal to the last one
+ * @param policy the threads the row updates may use
+ */
+template <typename T>
+typename Matrix<T>::Echelon Matrix<T>::eliminate(const std::size_t pivot_cols,
+                                                 const bool jordan,
+                                                 const ExecutionPolicy policy) {
+  Echelon e{};
+  std::vector<std::size_t> targets;
+  targets.reserve(_rows);
+
+  for (std::size_t col = 0; col < pivot_cols && e.rank < _rows; ++col) {
+    const std::size_t k = e.rank;
+
+    // find a pivot in this column
+    std::size_t p = k;
+    while (p < _rows && detail::is_zero_entry((*this)(p, col))) {
+      ++p;
+    }
+    if (p == _rows) {
+      continue; // no pivot: the column is dependent
+    }
+    if (p != k) {
+      swap_rows(p, k);
+      e.negate = !e.negate;
+    }
+
+    targets.clear();
+    for (std::size_t i = jordan ? 0 : k + 1; i < _rows; ++i) {
+      if (i != k) {
+        targets.push_back(i);
+      }
+    }
+
+    // the rows of one pivot step only read row k, so they update in parallel
+    const T &akk = (*this)(k, col);
+    const T &prev = e.last_pivot;
+    parallel_for(
+        0, targets.size(),
+        [&](const std::size_t t) {
+          const std::size_t i = targets[t];
+          const T aik = (*this)(i, col);
+          for (std::size_t j = col + 1; j < _cols; ++j) {
+            (*this)(i, j) = detail::bareiss_update(akk, (*this)(i, j), aik,
+                                                   (*this)(k, j), prev);
+          }
+          (*this)(i, col) = T{0};
+          if (jordan && i < k) {
+            (*this)(i, i) = akk; // the earlier pivots catch up
+          }
+        },
+        policy);
+
+    e.last_pivot = akk;
+    ++e.rank;
+  }
+  return e;
+}
+
+template <typename T>
+T Matrix<T>::determinant(const ExecutionPolicy policy) const {
+  if (_rows != _cols) {
+    throw std::invalid_argument("Matrix::determinant() : matrix is not square");
+  }
+  if (_rows == 0) {
+    return T{1};
+  }
+  Matrix m{*this};
+  const Echelon e = m.eliminate(_cols, false, policy);
+  if (e.rank < _rows) {
+    return T{0};
+  }
+  return e.negate ? T{0} - e.last_pivot : e.last_pivot;
+}
+
+template <typename T>
+std::size_t Matrix<T>::rank(const ExecutionPolicy policy) const {
+  Matrix m{*this};
+  return m.eliminate(_cols, false, policy).rank;
+}
+
+template <typename T>
+typename Matrix<T>::Solution
+Matrix<T>::solve(const std::vector<T> &b, const ExecutionPolicy policy) const {
+  if (_rows != _cols) {
+    throw std::invalid_argument("Matrix::solve() : matrix is not square");
+  }
+  if (b.size() != _rows) {
+    throw std::invalid_argument("Matrix::solve() : dimension mismatch");
+  }
+
+  Matrix augmented{_rows, _cols + 1};
+  for (std::size_t i = 0; i < _rows; ++i) {
+    for (std::size_t j = 0; j < _cols; ++j) {
+      augmented(i, j) = (*this)(i, j);
+    }
+    augmented(i, _cols) = b[i];
+  }
+
+  const Echelon e = augmented.eliminate(_cols, true, policy);
+  if (e.rank < _rows) {
+    throw std::runtime_error("Matrix::solve() : matrix is singular");
+  }
+
+  // every pivot is now last_pivot = +-det, so x_i = a(i, n) / last_pivot
+  Solution s{{}, e.last_pivot};
+  s.numerators.reserve(_rows);
+  for (std::size_t i = 0; i < _rows; ++i) {
+    s.numerators.push_back(augmented(i, _cols));
+  }
+  if (s.denominator < T{0}) {
+    s.denominator = T{0} - s.denominator;
+    for (auto &x : s.numerators) {
+      x = T{0} - x;
+    }
+  }
+  return s;
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_MATRIX_HPP_
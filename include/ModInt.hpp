@@ -0,0 +1,772 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file ModInt.hpp
+ * @brief Modular arithmetic with a compile-time or run-time modulus
+ *
+ * ModInt<Modulus> keeps a residue modulo a 64-bit constant; ModContext does
+ * the same for an arbitrary BigInt modulus chosen at run time. Both pick a
+ * reduction strategy for their modulus once, instead of paying for a full
+ * `(a * b) % m` long division on every step.
+ */
+
+#ifndef SCH_INCLUDE_MODINT_HPP_
+#define SCH_INCLUDE_MODINT_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace sch {
+
+/// Reduction strategy chosen for a modulus
+enum class Reduction : std::uint8_t {
+  montgomery, ///< odd (ModInt) or coprime to 10 (ModContext) moduli
+  barrett,    ///< everything else
+  special     ///< powers of 2 (ModInt) or powers of 10 (ModContext)
+};
+
+namespace detail {
+
+[[nodiscard]] constexpr bool is_power_of_two(const std::uint64_t m) {
+  return m != 0 && (m & (m - 1)) == 0;
+}
+
+/// @return -m^{-1} mod 2^64 for odd m
+[[nodiscard]] constexpr std::uint64_t neg_inv_2_64(const std::uint64_t m) {
+  std::uint64_t x = m; // m * m == 1 mod 8 for odd m: 3 correct bits
+  for (int i = 0; i < 5; ++i) {
+    x *= 2 - m * x; // each Newton step doubles the correct bits
+  }
+  return ~x + 1;
+}
+
+/// @return the high 128 bits of the 256-bit product a * b
+[[nodiscard]] constexpr __uint128_t mul_hi_128(const __uint128_t a,
+                                               const __uint128_t b) {
+  const auto a0 = static_cast<std::uint64_t>(a);
+  const auto a1 = static_cast<std::uint64_t>(a >> 64U);
+  const auto b0 = static_cast<std::uint64_t>(b);
+  const auto b1 = static_cast<std::uint64_t>(b >> 64U);
+  const __uint128_t p00 = static_cast<__uint128_t>(a0) * b0;
+  const __uint128_t p01 = static_cast<__uint128_t>(a0) * b1;
+  const __uint128_t p10 = static_cast<__uint128_t>(a1) * b0;
+  const __uint128_t p11 = static_cast<__uint128_t>(a1) * b1;
+  const __uint128_t mid = (p00 >> 64U) + static_cast<std::uint64_t>(p01) +
+                          static_cast<std::uint64_t>(p10);
+  return p11 + (p01 >> 64U) + (p10 >> 64U) + (mid >> 64U);
+}
+
+/// @return the magnitude of an integral value
+template <typename T>
+[[nodiscard]] constexpr std::uint64_t magnitude(const T val) {
+  if constexpr (std::is_signed_v<T>) {
+    return val < 0 ? 0 - static_cast<std::uint64_t>(val)
+                   : static_cast<std::uint64_t>(val);
+  } else {
+    return static_cast<std::uint64_t>(val);
+  }
+}
+
+/// @return the bits of a magnitude as 32-bit words, little endian order
+[[nodiscard]] inline std::vector<std::uint32_t> to_words(Limbs v) {
+  std::vector<std::uint32_t> words;
+  trim(v);
+  while (!is_zero(v)) {
+    words.push_back(static_cast<std::uint32_t>(
+        divmod_1(v.data(), v.data(), v.size(), std::uint64_t{1} << 32U)));
+    trim(v);
+  }
+  return words;
+}
+
+} // namespace detail
+
+// MODINT ----------------------------------------------------------------------
+
+/**
+ * @class ModInt
+ * @brief Residue modulo a compile-time constant
+ * @tparam Modulus the modulus, greater than 1
+ *
+ * Odd moduli keep their residues in Montgomery form (R = 2^64), powers of two
+ * reduce with a mask, and the remaining even moduli use Barrett reduction with
+ * a 128-bit reciprocal. value() always returns the ordinary residue.
+ */
+template <std::uint64_t Modulus> class ModInt {
+  static_assert(Modulus > 1, "ModInt : modulus must be greater than 1");
+
+public:
+  static constexpr Reduction REDUCTION =
+      detail::is_power_of_two(Modulus) ? Reduction::special
+      : Modulus % 2 == 1               ? Reduction::montgomery
+                                       : Reduction::barrett;
+
+  constexpr ModInt() = default;
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  constexpr ModInt(const T val) // NOLINT
+      : _value{to_internal(reduce_integral(val))} {}
+  explicit ModInt(const BigInt &val);
+
+  /// @return the residue in [0, Modulus)
+  [[nodiscard]] constexpr std::uint64_t value() const {
+    if constexpr (REDUCTION == Reduction::montgomery) {
+      return redc(_value);
+    } else {
+      return _value;
+    }
+  }
+  [[nodiscard]] static constexpr std::uint64_t modulus() { return Modulus; }
+
+  constexpr bool operator==(const ModInt &rhs) const {
+    return _value == rhs._value;
+  }
+  constexpr bool operator!=(const ModInt &rhs) const {
+    return _value != rhs._value;
+  }
+
+  constexpr ModInt operator+(const ModInt &rhs) const {
+    const std::uint64_t s = _value + rhs._value;
+    // s < _value means the sum wrapped past 2^64, which only happens when
+    // Modulus > 2^63 and the true sum is >= Modulus
+    return from_internal(s < _value || s >= Modulus ? s - Modulus : s);
+  }
+  constexpr ModInt operator-(const ModInt &rhs) const {
+    return from_internal(_value >= rhs._value ? _value - rhs._value
+                                              : _value - rhs._value + Modulus);
+  }
+  constexpr ModInt operator*(const ModInt &rhs) const {
+    return from_internal(
+        reduce(static_cast<__uint128_t>(_value) * rhs._value));
+  }
+  constexpr ModInt operator/(const ModInt &rhs) const {
+    return *this * rhs.inv();
+  }
+  constexpr ModInt operator-() const {
+    return from_internal(_value == 0 ? 0 : Modulus - _value);
+  }
+
+  constexpr ModInt &operator+=(const ModInt &rhs) {
+    return *this = *this + rhs;
+  }
+  constexpr ModInt &operator-=(const ModInt &rhs) {
+    return *this = *this - rhs;
+  }
+  constexpr ModInt &operator*=(const ModInt &rhs) {
+    return *this = *this * rhs;
+  }
+  constexpr ModInt &operator/=(const ModInt &rhs) {
+    return *this = *this / rhs;
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  [[nodiscard]] constexpr ModInt pow(T exp) const;
+
+  /**
+   * @return the multiplicative inverse
+   * @throws std::invalid_argument if the value is not coprime to Modulus
+   */
+  [[nodiscard]] constexpr ModInt inv() const;
+
+  friend std::ostream &operator<<(std::ostream &os, const ModInt &m) {
+    return os << m.value();
+  }
+
+private:
+  // constants
+  static constexpr std::uint64_t NEG_INV = detail::neg_inv_2_64(Modulus);
+  static constexpr std::uint64_t R1 = (~Modulus + 1) % Modulus; // 2^64 mod M
+  static constexpr std::uint64_t R2 = static_cast<std::uint64_t>(
+      static_cast<__uint128_t>(R1) * R1 % Modulus); // 2^128 mod M
+  static constexpr __uint128_t MU = ~static_cast<__uint128_t>(0) / Modulus;
+
+  /// residue, in Montgomery form when REDUCTION is montgomery
+  std::uint64_t _value{};
+
+  static constexpr ModInt from_internal(const std::uint64_t v) {
+    ModInt m;
+    m._value = v;
+    return m;
+  }
+
+  template <typename T>
+  static constexpr std::uint64_t reduce_integral(const T val) {
+    const std::uint64_t r = detail::magnitude(val) % Modulus;
+    if constexpr (std::is_signed_v<T>) {
+      return val < 0 && r != 0 ? Modulus - r : r;
+    } else {
+      return r;
+    }
+  }
+
+  /// Montgomery reduction, @return t / 2^64 mod M; requires t < M * 2^64
+  static constexpr std::uint64_t redc(const __uint128_t t) {
+    const auto t_lo = static_cast<std::uint64_t>(t);
+    const std::uint64_t u = t_lo * NEG_INV;
+    const __uint128_t um = static_cast<__uint128_t>(u) * Modulus;
+    // t + u * M is divisible by 2^64; the low halves carry iff t_lo != 0
+    const __uint128_t r = (t >> 64U) + (um >> 64U) + (t_lo != 0 ? 1 : 0);
+    return static_cast<std::uint64_t>(r >= Modulus ? r - Modulus : r);
+  }
+
+  /// @return the internal form of t, for t < M^2
+  static constexpr std::uint64_t reduce(const __uint128_t t) {
+    if constexpr (REDUCTION == Reduction::montgomery) {
+      return redc(t);
+    } else if constexpr (REDUCTION == Reduction::special) {
+      return static_cast<std::uint64_t>(t) & (Modulus - 1);
+    } else {
+      __uint128_t r = t - detail::mul_hi_128(t, MU) * Modulus;
+      while (r >= Modulus) {
+        r -= Modulus;
+      }
+      return static_cast<std::uint64_t>(r);
+    }
+  }
+
+  /// @return the internal form of a residue v < M
+  static constexpr std::uint64_t to_internal(const std::uint64_t v) {
+    if constexpr (REDUCTION == Reduction::montgomery) {
+      return redc(static_cast<__uint128_t>(v) * R2);
+    } else {
+      return v;
+    }
+  }
+};
+
+template <std::uint64_t Modulus>
+ModInt<Modulus>::ModInt(const BigInt &val) {
+  const ModInt base{BigInt::BASE};
+  ModInt res{};
+  const auto &limbs = val.limbs();
+  for (auto it = limbs.rbegin(); it != limbs.rend(); ++it) {
+    res = res * base + ModInt{*it};
+  }
+  *this = val.sign() == Sign::negative ? -res : res;
+}
+
+/**
+ * @tparam T A built-in integral type (signed or unsigned).
+ *           Must be non-negative when calling this function.
+ * @param exp  The exponent value.
+ * @return The value raised to exp.
+ * @throws std::invalid_argument if `exp` is negative.
+ */
+template <std::uint64_t Modulus>
+template <typename T, typename>
+constexpr ModInt<Modulus> ModInt<Modulus>::pow(const T exp) const {
+  if (exp < 0) {
+    throw std::invalid_argument("ModInt::pow() : negative exponent");
+  }
+  ModInt m_base = *this; // mutable copy
+  auto m_exp = detail::magnitude(exp);
+  ModInt res{1};
+  while (m_exp > 0) {
+    if (m_exp % 2 == 1) {
+      res *= m_base;
+    }
+    m_base *= m_base;
+    m_exp /= 2;
+  }
+  return res;
+}
+
+template <std::uint64_t Modulus>
+constexpr ModInt<Modulus> ModInt<Modulus>::inv() const {
+  // extended Euclid on the ordinary residue
+  __int128_t t = 0;
+  __int128_t new_t = 1;
+  __int128_t r = Modulus;
+  __int128_t new_r = value();
+  while (new_r != 0) {
+    const __int128_t q = r / new_r;
+    const __int128_t tmp_t = t - q * new_t;
+    t = new_t;
+    new_t = tmp_t;
+    const __int128_t tmp_r = r - q * new_r;
+    r = new_r;
+    new_r = tmp_r;
+  }
+  if (r != 1) {
+    throw std::invalid_argument("ModInt::inv() : value is not invertible");
+  }
+  if (t < 0) {
+    t += Modulus;
+  }
+  return ModInt{static_cast<std::uint64_t>(t)};
+}
+
+/**
+ * @brief Invert every element of [first, last) in place.
+ *
+ * Montgomery's trick: one inversion and 3(n-1) multiplications instead of n
+ * inversions.
+ * @throws std::invalid_argument if any element is not invertible
+ */
+template <typename BidirIt> void batch_inv(BidirIt first, BidirIt last) {
+  using Mod = typename std::iterator_traits<BidirIt>::value_type;
+  std::vector<Mod> prefix; // prefix[i] is the product of the first i elements
+  Mod acc{1};
+  for (auto it = first; it != last; ++it) {
+    prefix.push_back(acc);
+    acc *= *it;
+  }
+  acc = acc.inv(); // the inverse of the whole product
+  std::size_t i = prefix.size();
+  for (auto it = last; it != first;) {
+    --it;
+    --i;
+    const Mod elem = *it;
+    *it = acc * prefix[i];
+    acc *= elem; // now the inverse of the product of the first i elements
+  }
+}
+
+// MODCONTEXT ------------------------------------------------------------------
+
+/**
+ * @class ModContext
+ * @brief Modular arithmetic for a BigInt modulus chosen at run time
+ *
+ * The reduction strategy is chosen once, at construction:
+ * - special: the modulus is a power of ten, reduction truncates limbs
+ * - montgomery: the modulus is coprime to 10 (and so to the limb base);
+ *   pow() runs its ladder in Montgomery form; reduce() and a single mul(),
+ *   which would have to convert in and out, use Barrett
+ * - barrett: anything else
+ *
+ * Arguments are expected to be reduced, i.e. in [0, modulus()); anything else
+ * is reduced first. Results are always reduced. The batch overloads reuse one
+ * scratch buffer for the whole range.
+ */
+class ModContext {
+public:
+  /// @throws std::invalid_argument if `modulus` is less than 2
+  explicit ModContext(const BigInt &modulus);
+
+  [[nodiscard]] const BigInt &modulus() const { return _modulus; }
+  [[nodiscard]] Reduction reduction() const { return _reduction; }
+
+  /// @return x mod modulus(), in [0, modulus())
+  [[nodiscard]] BigInt reduce(const BigInt &x) const;
+  [[nodiscard]] BigInt add(const BigInt &a, const BigInt &b) const;
+  [[nodiscard]] BigInt sub(const BigInt &a, const BigInt &b) const;
+  [[nodiscard]] BigInt mul(const BigInt &a, const BigInt &b) const;
+
+  /// @throws std::invalid_argument if `exp` is negative
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  [[nodiscard]] BigInt pow(const BigInt &base, T exp) const;
+  /// @throws std::invalid_argument if `exp` is negative
+  [[nodiscard]] BigInt pow(const BigInt &base, const BigInt &exp) const;
+
+  // BATCH OPERATIONS ------------------------------------
+
+  template <typename InputIt, typename OutputIt>
+  OutputIt reduce(InputIt first, InputIt last, OutputIt d_first) const;
+  template <typename InputIt1, typename InputIt2, typename OutputIt>
+  OutputIt add(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+               OutputIt d_first) const;
+  template <typename InputIt1, typename InputIt2, typename OutputIt>
+  OutputIt sub(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+               OutputIt d_first) const;
+  template <typename InputIt1, typename InputIt2, typename OutputIt>
+  OutputIt mul(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+               OutputIt d_first) const;
+  template <typename InputIt, typename OutputIt>
+  OutputIt pow(InputIt first, InputIt last, const BigInt &exp,
+               OutputIt d_first) const;
+
+private:
+  using Limbs = detail::Limbs;
+  using Words = std::vector<std::uint32_t>;
+
+  /// below this many limbs in the modulus, Barrett uses truncated products
+  static constexpr std::size_t BARRETT_SHORT_LIMBS = 128;
+
+  BigInt _modulus;
+  Limbs _m;         ///< limbs of the modulus
+  std::size_t _k{}; ///< number of limbs in the modulus
+  Reduction _reduction{Reduction::barrett};
+
+  std::uint64_t _m_inv{}; ///< montgomery: -m^{-1} mod BASE
+  Limbs _r2;              ///< montgomery: BASE^(2k) mod m
+  Limbs _mu;              ///< barrett, montgomery: floor(BASE^(2k) / m)
+  std::size_t _p10_limbs{}; ///< special: m = BASE^_p10_limbs * _p10_top
+  std::uint64_t _p10_top{};
+
+  static void product(Limbs &r, const Limbs &a, const Limbs &b);
+  [[nodiscard]] Limbs reduced(const BigInt &x) const;
+  [[nodiscard]] Limbs special(Limbs x) const;
+  [[nodiscard]] Limbs barrett(const Limbs &x) const;
+  [[nodiscard]] Limbs barrett_any(const Limbs &x) const;
+  [[nodiscard]] Limbs redc(Limbs &t) const;
+  [[nodiscard]] Limbs mul_reduce(const Limbs &a, const Limbs &b,
+                                 Limbs &scratch) const;
+  [[nodiscard]] Limbs add_reduce(const Limbs &a, const Limbs &b) const;
+  [[nodiscard]] Limbs sub_reduce(const Limbs &a, const Limbs &b) const;
+  [[nodiscard]] Limbs pow_words(const Limbs &base, const Words &exp,
+                                Limbs &scratch) const;
+};
+
+inline ModContext::ModContext(const BigInt &modulus) : _modulus{modulus} {
+  if (modulus < 2) {
+    throw std::invalid_argument(
+        "ModContext::ModContext() : modulus must be greater than 1");
+  }
+  _m = modulus.limbs();
+  _k = _m.size();
+
+  // special: 10^j, i.e. zero limbs under a power of ten
+  const bool low_zero =
+      std::all_of(_m.begin(), _m.end() - 1,
+                  [](const std::uint64_t d) { return d == 0; });
+  std::uint64_t top = _m.back();
+  while (top % 10 == 0) {
+    top /= 10;
+  }
+  if (low_zero && top == 1) {
+    _reduction = Reduction::special;
+    _p10_limbs = _k - 1;
+    _p10_top = _m.back();
+    if (_p10_top == 1) { // m = BASE^(k-1): plain truncation
+      _p10_top = detail::LIMB_BASE;
+      --_p10_limbs;
+    }
+    return;
+  }
+
+  const std::uint64_t m0 = _m.front();
+  if (m0 % 2 != 0 && m0 % 5 != 0) {
+    _reduction = Reduction::montgomery;
+    _m_inv = (detail::LIMB_BASE - detail::inv_mod_base(m0)) %
+             detail::LIMB_BASE;
+    const BigInt r2 = BigInt{detail::shift_up(Limbs{1}, 2 * _k)} % _modulus;
+    _r2 = r2.limbs();
+  } else {
+    _reduction = Reduction::barrett;
+  }
+  _mu = (BigInt{detail::shift_up(Limbs{1}, 2 * _k)} / _modulus).limbs();
+}
+
+// REDUCTION KERNELS -----------------------------------------------------------
+
+/// r = a * b, with the Karatsuba kernels and squares as squares
+inline void ModContext::product(Limbs &r, const Limbs &a, const Limbs &b) {
+  r.assign(a.size() + b.size(), 0);
+  if (&a == &b) {
+    detail::sqr_karatsuba(r.data(), a.data(), a.size());
+  } else if (a.size() >= b.size()) {
+    detail::mul_karatsuba(r.data(), a.data(), a.size(), b.data(), b.size());
+  } else {
+    detail::mul_karatsuba(r.data(), b.data(), b.size(), a.data(), a.size());
+  }
+}
+
+/// @return x mod m for a power-of-ten m
+inline detail::Limbs ModContext::special(Limbs x) const {
+  if (x.size() > _p10_limbs) {
+    x.resize(_p10_limbs + 1);
+    x.back() %= _p10_top;
+  }
+  detail::trim(x);
+  return x;
+}
+
+/**
+ * @return x mod m for x < BASE^(2k)
+ *
+ * Below BARRETT_SHORT_LIMBS both products are truncated (HAC 14.42, 14.44):
+ * q3 comes from the columns of q1 * mu at k - 1 and up, which makes it at
+ * most 2 too small, and q3 * m is needed only mod BASE^(k+1). The two half
+ * school-book products beat two full Karatsuba ones up to about 128 limbs
+ * (measured at -O2: 12 against 23 us for a 50-limb modulus, even at 200).
+ */
+inline detail::Limbs ModContext::barrett(const Limbs &x) const {
+  if (x.size() < _k) { // x < BASE^(k-1) <= m
+    return x;
+  }
+  const std::size_t w = _k + 1; // the width of r1, r2 and r
+  Limbs r(w, 0);
+  std::copy_n(x.begin(), std::min(x.size(), w), r.begin());
+  Limbs r2(w, 0);
+  if (_k < BARRETT_SHORT_LIMBS) {
+    const std::uint64_t *const q1 = x.data() + (_k - 1);
+    const std::size_t qn = x.size() - (_k - 1);
+    const std::size_t mn = _mu.size();
+    Limbs t(qn + mn, 0);
+    for (std::size_t i = 0; i < qn; ++i) {
+      const std::size_t j = i + 1 >= _k ? 0 : _k - 1 - i;
+      if (j < mn) {
+        t[i + mn] = detail::addmul_1(&t[i + j], &_mu[j], mn - j, q1[i]);
+      }
+    }
+    const std::uint64_t *const q3 = t.data() + w;
+    const std::size_t q3n = t.size() - w;
+    for (std::size_t i = 0; i < std::min(q3n, w); ++i) {
+      const std::size_t n = std::min(_k, w - i);
+      const std::uint64_t carry = detail::addmul_1(&r2[i], _m.data(), n, q3[i]);
+      if (i + n < w) {
+        r2[i + n] = carry;
+      }
+    }
+  } else {
+    const Limbs q1 = detail::shift_down(x, _k - 1);
+    const Limbs q3 = detail::shift_down(detail::mul(q1, _mu), w);
+    const Limbs p = detail::mul(q3, _m);
+    std::copy_n(p.begin(), std::min(p.size(), w), r2.begin());
+  }
+  // r1 - r2 mod BASE^(k+1), the borrow out being that BASE^(k+1)
+  detail::sub_n(r.data(), r.data(), r2.data(), w);
+  detail::trim(r);
+  while (detail::compare(r, _m) >= 0) { // a few times at most
+    r = detail::sub(r, _m);
+  }
+  return r;
+}
+
+/// @return x mod m for any x, folding k limbs at a time from the top
+inline detail::Limbs ModContext::barrett_any(const Limbs &x) const {
+  if (x.size() <= 2 * _k) {
+    return barrett(x);
+  }
+  Limbs r{0};
+  for (std::size_t chunk = (x.size() - 1) / _k + 1; chunk-- > 0;) {
+    const auto lo = static_cast<std::ptrdiff_t>(chunk * _k);
+    const auto hi = static_cast<std::ptrdiff_t>(
+        std::min(x.size(), (chunk + 1) * _k));
+    Limbs t = detail::shift_up(r, _k);
+    t.resize(std::max(t.size(), _k), 0);
+    std::copy(x.begin() + lo, x.begin() + hi, t.begin());
+    detail::trim(t);
+    r = barrett(t); // r < m, so t < m * BASE^k < BASE^(2k)
+  }
+  return r;
+}
+
+/**
+ * Montgomery reduction (REDC) in base BASE with R = BASE^k.
+ * @param[in,out] t the value to reduce, t < m * R; used as scratch
+ * @return t * R^{-1} mod m
+ */
+inline detail::Limbs ModContext::redc(Limbs &t) const {
+  t.resize(2 * _k + 1, 0);
+  for (std::size_t i = 0; i < _k; ++i) {
+    const std::uint64_t u = detail::mul_mod_base(t[i], _m_inv);
+    const std::uint64_t carry = detail::addmul_1(&t[i], _m.data(), _k, u);
+    detail::add_1(&t[i + _k], t.size() - i - _k, carry);
+  }
+  Limbs r(t.begin() + static_cast<std::ptrdiff_t>(_k), t.end());
+  detail::trim(r);
+  if (detail::compare(r, _m) >= 0) {
+    r = detail::sub(r, _m);
+  }
+  return r;
+}
+
+/// @return the reduced magnitude of x
+inline detail::Limbs ModContext::reduced(const BigInt &x) const {
+  const Limbs &v = x.limbs();
+  if (v.empty()) {
+    return Limbs{0};
+  }
+  if (x.sign() == Sign::positive && detail::compare(v, _m) < 0) {
+    return v;
+  }
+  return reduce(x).limbs();
+}
+
+/**
+ * @param scratch reused product buffer
+ * @return a * b mod m, for reduced a and b
+ */
+inline detail::Limbs ModContext::mul_reduce(const Limbs &a, const Limbs &b,
+                                            Limbs &scratch) const {
+  product(scratch, a, b);
+  detail::trim(scratch);
+  switch (_reduction) {
+  case Reduction::special: return special(scratch);
+  // in and out of Montgomery form a single product would cost a second full
+  // product and two REDCs; Barrett reduces it with two products
+  case Reduction::barrett:
+  case Reduction::montgomery: return barrett(scratch);
+  }
+  return {};
+}
+
+inline detail::Limbs ModContext::add_reduce(const Limbs &a,
+                                            const Limbs &b) const {
+  Limbs s = detail::add(a, b);
+  if (detail::compare(s, _m) >= 0) {
+    s = detail::sub(s, _m);
+  }
+  return s;
+}
+
+inline detail::Limbs ModContext::sub_reduce(const Limbs &a,
+                                            const Limbs &b) const {
+  if (detail::compare(a, b) >= 0) {
+    return detail::sub(a, b);
+  }
+  return detail::sub(detail::add(a, _m), b);
+}
+
+/**
+ * Left-to-right binary exponentiation. Montgomery contexts stay in
+ * Montgomery form for the whole ladder and convert once at each end.
+ */
+inline detail::Limbs ModContext::pow_words(const Limbs &base, const Words &exp,
+                                           Limbs &scratch) const {
+  if (exp.empty()) {
+    return Limbs{1}; // the modulus is at least 2
+  }
+  const bool mont = _reduction == Reduction::montgomery;
+  const auto step = [&](const Limbs &a, const Limbs &b) {
+    if (!mont) {
+      return mul_reduce(a, b, scratch);
+    }
+    product(scratch, a, b);
+    return redc(scratch);
+  };
+  Limbs b = base;
+  if (mont) { // to Montgomery form: REDC(base * R^2) = base * R
+    product(scratch, b, _r2);
+    b = redc(scratch);
+  }
+  Limbs res = b; // the top bit of exp is set
+  std::size_t bit = 31;
+  while ((exp.back() >> bit & 1U) == 0) {
+    --bit;
+  }
+  for (std::size_t w = exp.size(); w-- > 0;) {
+    for (std::size_t i = w + 1 == exp.size() ? bit : 32; i-- > 0;) {
+      res = step(res, res);
+      if ((exp[w] >> i & 1U) != 0) {
+        res = step(res, b);
+      }
+    }
+  }
+  if (mont) { // out of Montgomery form
+    scratch = res;
+    res = redc(scratch);
+  }
+  return res;
+}
+
+// SCALAR OPERATIONS -----------------------------------------------------------
+
+inline BigInt ModContext::reduce(const BigInt &x) const {
+  Limbs r;
+  switch (_reduction) {
+  case Reduction::special: r = special(x.limbs()); break;
+  case Reduction::barrett:
+  case Reduction::montgomery: r = barrett_any(x.limbs()); break;
+  }
+  if (x.sign() == Sign::negative && !detail::is_zero(r)) {
+    r = detail::sub(_m, r);
+  }
+  return BigInt{std::move(r)};
+}
+
+inline BigInt ModContext::add(const BigInt &a, const BigInt &b) const {
+  return BigInt{add_reduce(reduced(a), reduced(b))};
+}
+
+inline BigInt ModContext::sub(const BigInt &a, const BigInt &b) const {
+  return BigInt{sub_reduce(reduced(a), reduced(b))};
+}
+
+inline BigInt ModContext::mul(const BigInt &a, const BigInt &b) const {
+  Limbs scratch;
+  return BigInt{mul_reduce(reduced(a), reduced(b), scratch)};
+}
+
+template <typename T, typename>
+BigInt ModContext::pow(const BigInt &base, const T exp) const {
+  if (exp < 0) {
+    throw std::invalid_argument("ModContext::pow() : negative exponent");
+  }
+  const std::uint64_t e = detail::magnitude(exp);
+  Words words{static_cast<std::uint32_t>(e),
+              static_cast<std::uint32_t>(e >> 32U)};
+  while (!words.empty() && words.back() == 0) {
+    words.pop_back();
+  }
+  Limbs scratch;
+  return BigInt{pow_words(reduced(base), words, scratch)};
+}
+
+inline BigInt ModContext::pow(const BigInt &base, const BigInt &exp) const {
+  if (exp.sign() == Sign::negative) {
+    throw std::invalid_argument("ModContext::pow() : negative exponent");
+  }
+  Limbs scratch;
+  return BigInt{
+      pow_words(reduced(base), detail::to_words(exp.limbs()), scratch)};
+}
+
+// BATCH OPERATIONS ------------------------------------------------------------
+
+template <typename InputIt, typename OutputIt>
+OutputIt ModContext::reduce(InputIt first, InputIt last,
+                            OutputIt d_first) const {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = reduce(*first);
+  }
+  return d_first;
+}
+
+template <typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt ModContext::add(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                         OutputIt d_first) const {
+  for (; first1 != last1; ++first1, ++first2, ++d_first) {
+    *d_first = BigInt{add_reduce(reduced(*first1), reduced(*first2))};
+  }
+  return d_first;
+}
+
+template <typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt ModContext::sub(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                         OutputIt d_first) const {
+  for (; first1 != last1; ++first1, ++first2, ++d_first) {
+    *d_first = BigInt{sub_reduce(reduced(*first1), reduced(*first2))};
+  }
+  return d_first;
+}
+
+template <typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt ModContext::mul(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                         OutputIt d_first) const {
+  Limbs scratch;
+  for (; first1 != last1; ++first1, ++first2, ++d_first) {
+    *d_first = BigInt{mul_reduce(reduced(*first1), reduced(*first2), scratch)};
+  }
+  return d_first;
+}
+
+template <typename InputIt, typename OutputIt>
+OutputIt ModContext::pow(InputIt first, InputIt last, const BigInt &exp,
+                         OutputIt d_first) const {
+  if (exp.sign() == Sign::negative) {
+    throw std::invalid_argument("ModContext::pow() : negative exponent");
+  }
+  const Words words = detail::to_words(exp.limbs());
+  Limbs scratch;
+  for (; first != last; ++first, ++d_first) {
+    *d_first = BigInt{pow_words(reduced(*first), words, scratch)};
+  }
+  return d_first;
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_MODINT_HPP_
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file Poly.hpp
+ * @brief Polynomials with BigInt coefficients
+ */
+
+#ifndef SCH_INCLUDE_POLY_HPP_
+#define SCH_INCLUDE_POLY_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sch {
+
+/**
+ * @class Poly
+ * @brief Dense univariate polynomial with BigInt coefficients
+ *
+ * Multiplication uses Kronecker substitution: both operands are evaluated at
+ * X = BASE^k, large enough that every product coefficient fits in k limbs,
+ * which packs each polynomial into one BigInt. A single BigInt multiplication
+ * then does all the work, and the product coefficients are read back from
+ * its limbs in balanced (signed) form.
+ */
+class Poly {
+public:
+  struct Interpolant;
+
+  Poly() = default; ///< the zero polynomial
+  Poly(std::initializer_list<BigInt> coeffs);
+  explicit Poly(std::vector<BigInt> coeffs);
+
+  /// @return x^n
+  [[nodiscard]] static Poly monomial(std::size_t n);
+
+  /// @return the degree; -1 for the zero polynomial
+  [[nodiscard]] std::ptrdiff_t degree() const {
+    return static_cast<std::ptrdiff_t>(_coeffs.size()) - 1;
+  }
+  [[nodiscard]] bool is_zero() const { return _coeffs.empty(); }
+  /// @return the coefficients, lowest degree first, with no trailing zeros
+  [[nodiscard]] const std::vector<BigInt> &coeffs() const { return _coeffs; }
+  /// @return the coefficient of x^i, zero past the degree
+  [[nodiscard]] BigInt operator[](std::size_t i) const;
+
+  bool operator==(const Poly &rhs) const { return _coeffs == rhs._coeffs; }
+  bool operator!=(const Poly &rhs) const { return !(*this == rhs); }
+
+  Poly operator+(const Poly &rhs) const;
+  Poly operator-(const Poly &rhs) const;
+  Poly operator*(const Poly &rhs) const;
+  /// @throws std::invalid_argument unless rhs has leading coefficient +-1
+  Poly operator/(const Poly &rhs) const;
+  /// @throws std::invalid_argument unless rhs has leading coefficient +-1
+  Poly operator%(const Poly &rhs) const;
+  Poly operator-() const;
+
+  Poly &operator+=(const Poly &rhs) { return *this = *this + rhs; }
+  Poly &operator-=(const Poly &rhs) { return *this = *this - rhs; }
+  Poly &operator*=(const Poly &rhs) { return *this = *this * rhs; }
+
+  /**
+   * @brief Division by a polynomial with leading coefficient +-1, which keeps
+   *        the quotient and remainder integral.
+   * @return {quotient, remainder}
+   * @throws std::invalid_argument if `divisor` is zero or not (+-)monic
+   */
+  [[nodiscard]] std::pair<Poly, Poly> divmod(const Poly &divisor) const;
+
+  [[nodiscard]] Poly derivative() const;
+
+  /// @return the value at x (Horner's rule)
+  [[nodiscard]] BigInt operator()(const BigInt &x) const;
+
+  /**
+   * @brief Multipoint evaluation through a subproduct tree.
+   *
+   * The polynomial is reduced modulo the products of the points' linear
+   * factors, halving the point set each level, so that each leaf holds only a
+   * short remainder to evaluate.
+   * @param out receives the values, one per point
+   */
+  template <typename InputIt, typename OutputIt>
+  OutputIt evaluate(InputIt first, InputIt last, OutputIt out) const;
+
+  /**
+   * @brief The polynomial of least degree through (xs[i], ys[i]).
+   *
+   * Lagrange interpolation over a subproduct tree, scaled to a common
+   * denominator so the arithmetic stays integral.
+   * @return the interpolant in lowest terms, with a positive denominator
+   * @throws std::invalid_argument if the sizes differ, no points are given or
+   *         two x values coincide
+   */
+  [[nodiscard]] static Interpolant interpolate(const std::vector<BigInt> &xs,
+                                               const std::vector<BigInt> &ys);
+
+  friend std::ostream &operator<<(std::ostream &os, const Poly &p);
+
+private:
+  std::vector<BigInt> _coeffs{}; ///< @note lowest degree first
+
+  /// below this many points a node is evaluated with Horner's rule
+  static constexpr std::size_t LEAF_POINTS = 8;
+
+  /// product trees, level 0 holds the linear factors (x - x_i)
+  using Tree = std::vector<std::vector<Poly>>;
+
+  void normalize();
+  [[nodiscard]] static Poly kronecker(const Poly &lhs, const Poly &rhs);
+  [[nodiscard]] static Tree subproduct_tree(const std::vector<BigInt> &xs);
+  static void evaluate_down(const Tree &tree, std::size_t level,
+                            std::size_t index, const Poly &rem,
+                            const std::vector<BigInt> &xs, std::size_t offset,
+                            std::vector<BigInt> &values);
+};
+
+/// an interpolating polynomial, numerator / denominator
+struct Poly::Interpolant {
+  Poly numerator;
+  BigInt denominator;
+};
+
+// CONSTRUCTORS ----------------------------------------------------------------
+
+inline Poly::Poly(const std::initializer_list<BigInt> coeffs)
+    : _coeffs(coeffs) {
+  normalize();
+}
+
+inline Poly::Poly(std::vector<BigInt> coeffs) : _coeffs{std::move(coeffs)} {
+  normalize();
+}
+
+inline Poly Poly::monomial(const std::size_t n) {
+  std::vector<BigInt> coeffs(n + 1, BigInt{0});
+  coeffs.back() = 1;
+  return Poly{std::move(coeffs)};
+}
+
+inline void Poly::normalize() {
+  while (!_coeffs.empty() && _coeffs.back() == 0) {
+    _coeffs.pop_back();
+  }
+}
+
+inline BigInt Poly::operator[](const std::size_t i) const {
+  return i < _coeffs.size() ? _coeffs[i] : BigInt{0};
+}
+
+// ARITHMETIC OPERATORS --------------------------------------------------------
+
+inline Poly Poly::operator+(const Poly &rhs) const {
+  std::vector<BigInt> sum(std::max(_coeffs.size(), rhs._coeffs.size()),
+                          BigInt{0});
+  for (std::size_t i = 0; i < sum.size(); ++i) {
+    sum[i] = (*this)[i] + rhs[i];
+  }
+  return Poly{std::move(sum)};
+}
+
+inline Poly Poly::operator-(const Poly &rhs) const {
+  std::vector<BigInt> difference(
+      std::max(_coeffs.size(), rhs._coeffs.size()), BigInt{0});
+  for (std::size_t i = 0; i < difference.size(); ++i) {
+    difference[i] = (*this)[i] - rhs[i];
+  }
+  return Poly{std::move(difference)};
+}
+
+inline Poly Poly::operator-() const {
+  Poly negation{*this};
+  for (auto &c : negation._coeffs) {
+    c = -c;
+  }
+  return negation;
+}
+
+inline Poly Poly::operator*(const Poly &rhs) const {
+  if (is_zero() || rhs.is_zero()) {
+    return Poly{};
+  }
+  return kronecker(*this, rhs);
+}
+
+inline Poly Poly::kronecker(const Poly &lhs, const Poly &rhs) {
+  using detail::Limbs;
+
+  // |product coefficient| <= min(n, m) * max|a_i| * max|b_j| =: bound, and
+  // balanced digits need BASE^k > 2 * bound
+  const auto max_limbs = [](const Poly &p) {
+    const auto it = std::max_element(
+        p._coeffs.begin(), p._coeffs.end(),
+        [](const BigInt &x, const BigInt &y) {
+          return detail::compare(x.limbs(), y.limbs()) < 0;
+        });
+    return it->limbs();
+  };
+  const std::size_t terms = std::min(lhs._coeffs.size(), rhs._coeffs.size());
+  Limbs bound = detail::mul(max_limbs(lhs), max_limbs(rhs));
+  bound.push_back(0);
+  detail::mul_1(bound.data(), bound.data(), bound.size(), 2 * terms);
+  detail::trim(bound);
+  const std::size_t k = bound.size();
+
+  // pack sum(c_i X^i) as (positive part) - (negative part)
+  const auto pack = [k](const Poly &p) {
+    Limbs positive(p._coeffs.size() * k, 0);
+    Limbs negative(p._coeffs.size() * k, 0);
+    for (std::size_t i = 0; i < p._coeffs.size(); ++i) {
+      const BigInt &c = p._coeffs[i];
+      Limbs &dst = c.sign() == Sign::negative ? negative : positive;
+      std::copy(c.limbs().begin(), c.limbs().end(),
+                dst.begin() + static_cast<std::ptrdiff_t>(i * k));
+    }
+    return BigInt{std::move(positive)} - BigInt{std::move(negative)};
+  };
+  const BigInt packed_lhs = pack(lhs);
+  const BigInt product = &lhs == &rhs || lhs == rhs ? packed_lhs * packed_lhs
+                                                    : packed_lhs * pack(rhs);
+
+  // unpack in balanced form: digits >= X / 2 become negative with a carry
+  const std::size_t n = lhs._coeffs.size() + rhs._coeffs.size() - 1;
+  const bool negate = product.sign() == Sign::negative;
+  const Limbs &packed = product.limbs();
+  // k >= 1 already; max() lets the compiler see it, for -Warray-bounds
+  Limbs half(std::max<std::size_t>(k, 1), 0);
+  half.back() = BigInt::BASE / 2;
+  Limbs x_k(k + 1, 0); // X = BASE^k
+  x_k.back() = 1;
+
+  std::vector<BigInt> coeffs;
+  coeffs.reserve(n);
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    Limbs digit(k + 1, 0);
+    const std::size_t lo = std::min(i * k, packed.size());
+    const std::size_t hi = std::min(lo + k, packed.size());
+    std::copy(packed.begin() + static_cast<std::ptrdiff_t>(lo),
+              packed.begin() + static_cast<std::ptrdiff_t>(hi), digit.begin());
+    detail::add_1(digit.data(), digit.size(), carry);
+    detail::trim(digit);
+
+    BigInt c;
+    if (detail::compare(digit, half) >= 0) {
+      c = -BigInt{detail::sub(x_k, digit)};
+      carry = 1;
+    } else {
+      c = BigInt{std::move(digit)};
+      carry = 0;
+    }
+    coeffs.push_back(negate ? -std::move(c) : std::move(c));
+  }
+  return Poly{std::move(coeffs)};
+}
+
+inline std::pair<Poly, Poly> Poly::divmod(const Poly &divisor) const {
+  if (divisor.is_zero()) {
+    throw std::invalid_argument("Poly::divmod() : division by zero");
+  }
+  const BigInt &lead = divisor._coeffs.back();
+  if (lead != 1 && lead != -1) {
+    throw std::invalid_argument(
+        "Poly::divmod() : divisor must have leading coefficient 1 or -1");
+  }
+  if (degree() < divisor.degree()) {
+    return {Poly{}, *this};
+  }
+
+  const std::size_t m = divisor._coeffs.size();
+  std::vector<BigInt> rem = _coeffs;
+  std::vector<BigInt> quot(rem.size() - m + 1, BigInt{0});
+  for (std::size_t i = quot.size(); i-- > 0;) {
+    const BigInt &top = rem[i + m - 1];
+    if (top == 0) {
+      continue;
+    }
+    quot[i] = lead == 1 ? top : -top;
+    for (std::size_t j = 0; j + 1 < m; ++j) {
+      if (divisor._coeffs[j] != 0) {
+        rem[i + j] -= quot[i] * divisor._coeffs[j];
+      }
+    }
+    rem[i + m - 1] = 0;
+  }
+  return {Poly{std::move(quot)}, Poly{std::move(rem)}};
+}
+
+inline Poly Poly::operator/(const Poly &rhs) const { return divmod(rhs).first; }
+
+inline Poly Poly::operator%(const Poly &rhs) const {
+  return divmod(rhs).second;
+}
+
+inline Poly Poly::derivative() const {
+  if (_coeffs.size() < 2) {
+    return Poly{};
+  }
+  std::vector<BigInt> d(_coeffs.size() - 1, BigInt{0});
+  for (std::size_t i = 1; i < _coeffs.size(); ++i) {
+    d[i - 1] = _coeffs[i] * BigInt{i};
+  }
+  return Poly{std::move(d)};
+}
+
+// EVALUATION ------------------------------------------------------------------
+
+inline BigInt Poly::operator()(const BigInt &x) const {
+  BigInt value = 0;
+  for (auto it = _coeffs.rbegin(); it != _coeffs.rend(); ++it) {
+    value = value * x + *it;
+  }
+  return value;
+}
+
+inline Poly::Tree Poly::subproduct_tree(const std::vector<BigInt> &xs) {
+  Tree tree(1);
+  tree[0].reserve(xs.size());
+  for (const auto &x : xs) {
+    tree[0].push_back(Poly{-x, 1});
+  }
+  while (tree.back().size() > 1) {
+    const auto &below = tree.back();
+    std::vector<Poly> level;
+    level.reserve((below.size() + 1) / 2);
+    for (std::size_t i = 0; i + 1 < below.size(); i += 2) {
+      level.push_back(below[i] * below[i + 1]);
+    }
+    if (below.size() % 2 == 1) {
+      level.push_back(below.back());
+    }
+    tree.push_back(std::move(level));
+  }
+  return tree;
+}
+
+/**
+ * Reduces `rem` down the subtree rooted at tree[level][index], whose points are
+ * xs[offset, offset + 2^level) (clipped to xs.size()).
+ */
+inline void Poly::evaluate_down(const Tree &tree, // NOLINT recursion
+                                const std::size_t level,
+                                const std::size_t index, const Poly &rem,
+                                const std::vector<BigInt> &xs,
+                                const std::size_t offset,
+                                std::vector<BigInt> &values) {
+  const std::size_t span = std::size_t{1} << level;
+  const std::size_t end = std::min(offset + span, xs.size());
+  if (end - offset <= LEAF_POINTS || level == 0) {
+    for (std::size_t i = offset; i < end; ++i) {
+      values[i] = rem(xs[i]);
+    }
+    return;
+  }
+  const auto &children = tree[level - 1];
+  const std::size_t left = 2 * index;
+  evaluate_down(tree, level - 1, left, rem % children[left], xs, offset,
+                values);
+  if (left + 1 < children.size()) {
+    evaluate_down(tree, level - 1, left + 1, rem % children[left + 1], xs,
+                  offset + span / 2, values);
+  }
+}
+
+template <typename InputIt, typename OutputIt>
+OutputIt Poly::evaluate(InputIt first, InputIt last, OutputIt out) const {
+  const std::vector<BigInt> xs(first, last);
+  if (xs.empty()) {
+    return out;
+  }
+  std::vector<BigInt> values(xs.size(), BigInt{0});
+  if (xs.size() <= LEAF_POINTS) {
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      values[i] = (*this)(xs[i]);
+    }
+  } else {
+    const Tree tree = subproduct_tree(xs);
+    const std::size_t top = tree.size() - 1;
+    evaluate_down(tree, top, 0, *this % tree[top][0], xs, 0, values);
+  }
+  return std::move(values.begin(), values.end(), out);
+}
+
+// INTERPOLATION ---------------------------------------------------------------
+
+namespace detail {
+
+[[nodiscard]] inline BigInt gcd(BigInt a, BigInt b) {
+  if (a < 0) {
+    a = -a;
+  }
+  if (b < 0) {
+    b = -b;
+  }
+  while (b != 0) {
+    a = std::exchange(b, a % b);
+  }
+  return a;
+}
+
+} // namespace detail
+
+inline Poly::Interpolant Poly::interpolate(const std::vector<BigInt> &xs,
+                                           const std::vector<BigInt> &ys) {
+  if (xs.size() != ys.size() || xs.empty()) {
+    throw std::invalid_argument(
+        "Poly::interpolate() : need equally many x and y values");
+  }
+  const std::size_t n = xs.size();
+  const Tree tree = subproduct_tree(xs);
+
+  // w_i = M'(x_i) = prod_{j != i} (x_i - x_j)
+  std::vector<BigInt> w(n, BigInt{0});
+  tree.back()[0].derivative().evaluate(xs.begin(), xs.end(), w.begin());
+  if (std::any_of(w.begin(), w.end(), [](const BigInt &x) { return x == 0; })) {
+    throw std::invalid_argument("Poly::interpolate() : repeated x value");
+  }
+
+  // common denominator D = lcm |w_i|, then P = sum (y_i D / w_i) M / (x - x_i)
+  BigInt denominator = 1;
+  for (const auto &wi : w) {
+    denominator = denominator / detail::gcd(denominator, wi) * wi;
+  }
+  if (denominator < 0) {
+    denominator = -denominator;
+  }
+
+  // combine up the tree: N(node) = N(left) M(right) + N(right) M(left)
+  std::vector<Poly> level;
+  level.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    level.push_back(Poly{ys[i] * divexact(denominator, w[i])});
+  }
+  for (std::size_t l = 0; l + 1 < tree.size(); ++l) {
+    std::vector<Poly> above;
+    above.reserve((level.size() + 1) / 2);
+    for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+      above.push_back(level[i] * tree[l][i + 1] + level[i + 1] * tree[l][i]);
+    }
+    if (level.size() % 2 == 1) {
+      above.push_back(std::move(level.back()));
+    }
+    level = std::move(above);
+  }
+
+  // lowest terms
+  Interpolant result{std::move(level.front()), std::move(denominator)};
+  BigInt g = result.denominator;
+  for (const auto &c : result.numerator._coeffs) {
+    if (g == 1) {
+      break;
+    }
+    g = detail::gcd(g, c);
+  }
+  if (g != 1) {
+    for (auto &c : result.numerator._coeffs) {
+      c = divexact(c, g);
+    }
+    result.denominator = divexact(result.denominator, g);
+  }
+  return result;
+}
+
+// OUTPUT ----------------------------------------------------------------------
+
+inline std::ostream &operator<<(std::ostream &os, const Poly &p) {
+  if (p.is_zero()) {
+    return os << 0;
+  }
+  bool first = true;
+  for (std::size_t i = p._coeffs.size(); i-- > 0;) {
+    const BigInt &c = p._coeffs[i];
+    if (c == 0) {
+      continue;
+    }
+    if (!first) {
+      os << (c < 0 ? " - " : " + ");
+    } else if (c < 0) {
+      os << '-';
+    }
+    const BigInt magnitude = c < 0 ? -c : c;
+    if (magnitude != 1 || i == 0) {
+      os << magnitude;
+    }
+    if (i >= 1) {
+      os << 'x';
+    }
+    if (i >= 2) {
+      os << '^' << i;
+    }
+    first = false;
+  }
+  return os;
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_POLY_HPP_
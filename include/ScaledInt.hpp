@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file ScaledInt.hpp
+ * @brief Integers with their trailing zero limbs kept as an exponent
+ */
+
+#ifndef SCH_INCLUDE_SCALEDINT_HPP_
+#define SCH_INCLUDE_SCALEDINT_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace sch {
+
+/**
+ * @class ScaledInt
+ * @brief An integer stored as mantissa * BASE^exponent, for values such as
+ *        m * 10^k with large k.
+ *
+ * The mantissa never ends in a zero limb, so a value's trailing zeros cost
+ * nothing: scaling by BASE^k, or by 10^k up to one short multiplication, only
+ * moves the exponent, and products and sums work on the mantissas alone.
+ */
+class ScaledInt {
+public:
+  ScaledInt() = default; ///< zero
+  ScaledInt(const BigInt &value) : _mantissa{value} { // NOLINT implicit
+    normalize();
+  }
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  ScaledInt(const T val) : ScaledInt(BigInt{val}) {} // NOLINT implicit
+  /// mantissa * BASE^exponent
+  ScaledInt(BigInt mantissa, const std::size_t exponent)
+      : _mantissa{std::move(mantissa)}, _exponent{exponent} {
+    normalize();
+  }
+
+  /// @return 10^k, without computing it
+  [[nodiscard]] static ScaledInt pow10(const std::size_t k) {
+    const auto exp = static_cast<std::size_t>(BigInt::EXP);
+    return ScaledInt{BigInt{detail::pow10(k % exp)}, k / exp};
+  }
+
+  /// @return the mantissa, zero or ending in a nonzero limb
+  [[nodiscard]] const BigInt &mantissa() const { return _mantissa; }
+  /// @return the number of trailing zero limbs
+  [[nodiscard]] std::size_t exponent() const { return _exponent; }
+  [[nodiscard]] bool is_zero() const {
+    return detail::is_zero(_mantissa.limbs());
+  }
+
+  /// @return the value as a BigInt, with all its limbs
+  [[nodiscard]] BigInt to_bigint() const;
+  [[nodiscard]] std::string to_string() const;
+
+  bool operator==(const ScaledInt &rhs) const {
+    return _exponent == rhs._exponent && _mantissa == rhs._mantissa;
+  }
+  bool operator!=(const ScaledInt &rhs) const { return !(*this == rhs); }
+  bool operator<(const ScaledInt &rhs) const;
+  bool operator>(const ScaledInt &rhs) const { return rhs < *this; }
+  bool operator<=(const ScaledInt &rhs) const { return !(rhs < *this); }
+  bool operator>=(const ScaledInt &rhs) const { return !(*this < rhs); }
+
+  ScaledInt operator+(const ScaledInt &rhs) const;
+  ScaledInt operator-(const ScaledInt &rhs) const { return *this + -rhs; }
+  ScaledInt operator*(const ScaledInt &rhs) const;
+  ScaledInt operator-() const { return ScaledInt{-_mantissa, _exponent}; }
+
+  ScaledInt &operator+=(const ScaledInt &rhs) { return *this = *this + rhs; }
+  ScaledInt &operator-=(const ScaledInt &rhs) { return *this = *this - rhs; }
+  ScaledInt &operator*=(const ScaledInt &rhs) { return *this = *this * rhs; }
+
+  /// multiply by BASE^k, in O(1)
+  ScaledInt &scale(std::size_t k);
+  /// multiply by 10^k: the exponent, and the mantissa by 10^(k % EXP)
+  ScaledInt &mul_pow10(std::size_t k);
+
+  friend std::ostream &operator<<(std::ostream &os, const ScaledInt &x) {
+    return os << x.to_string();
+  }
+
+private:
+  BigInt _mantissa{0};
+  std::size_t _exponent = 0;
+
+  /// move the mantissa's trailing zero limbs into the exponent
+  void normalize();
+};
+
+// MEMBER FUNCTIONS ------------------------------------------------------------
+
+inline void ScaledInt::normalize() {
+  const detail::Limbs &m = _mantissa.limbs();
+  if (detail::is_zero(m)) {
+    _mantissa = 0;
+    _exponent = 0;
+    return;
+  }
+  std::size_t k = 0;
+  while (m[k] == 0) {
+    ++k;
+  }
+  if (k > 0) {
+    BigInt shifted{detail::shift_down(m, k)};
+    _mantissa = _mantissa < 0 ? -std::move(shifted) : std::move(shifted);
+    _exponent += k;
+  }
+}
+
+inline BigInt ScaledInt::to_bigint() const {
+  if (_exponent == 0) {
+    return _mantissa;
+  }
+  BigInt value{detail::shift_up(_mantissa.limbs(), _exponent)};
+  return _mantissa < 0 ? -std::move(value) : value;
+}
+
+inline std::string ScaledInt::to_string() const {
+  if (is_zero()) {
+    return "0";
+  }
+  std::string str = _mantissa.to_string();
+  str.append(_exponent * static_cast<std::size_t>(BigInt::EXP), '0');
+  return str;
+}
+
+inline ScaledInt &ScaledInt::scale(const std::size_t k) {
+  if (!is_zero()) {
+    _exponent += k;
+  }
+  return *this;
+}
+
+inline ScaledInt &ScaledInt::mul_pow10(const std::size_t k) {
+  const auto exp = static_cast<std::size_t>(BigInt::EXP);
+  if (k % exp != 0) {
+    *this = ScaledInt{_mantissa * detail::pow10(k % exp), _exponent};
+  }
+  return scale(k / exp);
+}
+
+// COMPARISON ------------------------------------------------------------------
+
+inline bool ScaledInt::operator<(const ScaledInt &rhs) const {
+  const bool negative = _mantissa < 0;
+  if (negative != (rhs._mantissa < 0)) {
+    return negative;
+  }
+  // compare magnitudes: first by length, then limb by limb from the top
+  const detail::Limbs &a = _mantissa.limbs();
+  const detail::Limbs &b = rhs._mantissa.limbs();
+  const std::size_t la = is_zero() ? 0 : a.size() + _exponent;
+  const std::size_t lb = rhs.is_zero() ? 0 : b.size() + rhs._exponent;
+  int order = la < lb ? -1 : la > lb ? 1 : 0;
+  const std::size_t low = std::min(_exponent, rhs._exponent);
+  for (std::size_t p = la; order == 0 && p-- > low;) {
+    const std::uint64_t x = p >= _exponent ? a[p - _exponent] : 0;
+    const std::uint64_t y = p >= rhs._exponent ? b[p - rhs._exponent] : 0;
+    order = x < y ? -1 : x > y ? 1 : 0;
+  }
+  return negative ? order > 0 : order < 0;
+}
+
+// ARITHMETIC ------------------------------------------------------------------
+
+inline ScaledInt ScaledInt::operator+(const ScaledInt &rhs) const {
+  if (is_zero()) {
+    return rhs;
+  }
+  if (rhs.is_zero()) {
+    return *this;
+  }
+  // line the mantissas up at the lower exponent; the limbs below the other
+  // operand's exponent carry over unchanged
+  const ScaledInt &low = _exponent <= rhs._exponent ? *this : rhs;
+  const ScaledInt &high = _exponent <= rhs._exponent ? rhs : *this;
+  const std::size_t d = high._exponent - low._exponent;
+  if (d == 0) {
+    return ScaledInt{_mantissa + rhs._mantissa, _exponent};
+  }
+  BigInt shifted{detail::shift_up(high._mantissa.limbs(), d)};
+  if (high._mantissa < 0) {
+    shifted = -std::move(shifted);
+  }
+  return ScaledInt{low._mantissa + shifted, low._exponent};
+}
+
+inline ScaledInt ScaledInt::operator*(const ScaledInt &rhs) const {
+  if (is_zero() || rhs.is_zero()) {
+    return {};
+  }
+  return ScaledInt{_mantissa * rhs._mantissa, _exponent + rhs._exponent};
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_SCALEDINT_HPP_
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file async.hpp
+ * @brief Long-running operations in the background, with cancellation and
+ *        progress
+ *
+ * sch::async::mul, div, pow and factorial start the operation and return a
+ * Future at once. The work runs on the executor (see parallel.hpp), or on a
+ * thread of its own when the executor has no thread to spare. Cancelling
+ * makes the kernels throw OperationCancelled at their next recursion
+ * boundary, which get() rethrows; a deadline is a wait_until() followed by a
+ * cancel().
+ *
+ * Progress is the fraction of the limb products done out of an estimate made
+ * up front from the operand sizes, so it moves in steps of the kernels'
+ * leaves and is exact only for a single multiplication.
+ *
+ * An operation over the calling thread's budget (see budget.hpp) throws
+ * BudgetExceeded from the call that would start it.
+ */
+
+#ifndef SCH_INCLUDE_ASYNC_HPP_
+#define SCH_INCLUDE_ASYNC_HPP_
+
+#include "BigInt.hpp"
+#include "cancel.hpp"
+#include "limbs.hpp"
+#include "parallel.hpp"
+#include "series.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace sch {
+
+namespace detail {
+
+// WORK ESTIMATES --------------------------------------------------------------
+// limb products done by the kernels of limbs.hpp, mirroring their recursion
+
+inline const double LOG_BASE = std::log(static_cast<double>(LIMB_BASE));
+
+class WorkEstimate {
+public:
+  /// @return the leaf work of mul_karatsuba on an x bn limbs, an >= bn
+  double mul(const std::size_t an, const std::size_t bn) { // NOLINT recursion
+    if (bn == 0) {
+      return 0;
+    }
+    if (bn < KARATSUBA_THRESHOLD) {
+      return static_cast<double>(an) * static_cast<double>(bn);
+    }
+    const auto found = _mul.find({an, bn});
+    if (found != _mul.end()) {
+      return found->second;
+    }
+    const std::size_t h = (an + 1) / 2;
+    double work = 0;
+    if (bn <= h) {
+      const std::size_t rest = an % bn;
+      work = static_cast<double>(an / bn) * mul(bn, bn) + mul(bn, rest);
+    } else {
+      work = mul(h, h) + mul(an - h, bn - h) + mul(h + 1, h + 1);
+    }
+    _mul.emplace(std::make_pair(an, bn), work);
+    return work;
+  }
+
+  /// @return the leaf work of sqr_karatsuba on n limbs
+  double sqr(const std::size_t n) { // NOLINT recursion
+    if (n < KARATSUBA_THRESHOLD) {
+      return static_cast<double>(n) * static_cast<double>(n + 1) / 2;
+    }
+    const auto found = _sqr.find(n);
+    if (found != _sqr.end()) {
+      return found->second;
+    }
+    const std::size_t h = (n + 1) / 2;
+    const double work = sqr(h) + sqr(n - h) + sqr(h + 1);
+    _sqr.emplace(n, work);
+    return work;
+  }
+
+  /// @return the work of divmod() of an by bn limbs
+  double div(const std::size_t an, const std::size_t bn) {
+    if (bn < 2 || an < bn) {
+      return 0;
+    }
+    if (bn < DIV_NEWTON_THRESHOLD) {
+      return static_cast<double>(an - bn + 1) * static_cast<double>(bn);
+    }
+    const double chunks = std::ceil(static_cast<double>(an) / bn);
+    return reciprocal(bn) + chunks * (mul(2 * bn, bn + 1) + mul(bn, bn));
+  }
+
+  /// @return the work of pow() with exponent exp, log_base = log |base|
+  double pow(const double log_base, std::uint64_t exp) {
+    // base^k has about k log |base| / log BASE limbs
+    const double per_power = log_base / LOG_BASE;
+    double work = 0;
+    std::uint64_t done = 0; // the exponent of res so far
+    for (std::uint64_t power = 1; exp > 0; power *= 2) {
+      const std::size_t square = limbs(per_power * static_cast<double>(power));
+      if (exp % 2 == 1) {
+        const std::size_t res = limbs(per_power * static_cast<double>(done));
+        work += mul(std::max(res, square), std::min(res, square));
+        done += power;
+      }
+      exp /= 2;
+      if (exp > 0) {
+        work += sqr(square);
+      }
+    }
+    return work;
+  }
+
+  /// @return the work of factorial(n), over the tree of product_range()
+  double factorial(const std::uint64_t n) {
+    return n < 2 ? 0 : product(2, n + 1);
+  }
+
+private:
+  static std::size_t limbs(const double x) {
+    return static_cast<std::size_t>(std::ceil(x));
+  }
+
+  double reciprocal(const std::size_t k) { // NOLINT recursion
+    if (k < DIV_NEWTON_THRESHOLD / 2) {
+      return static_cast<double>(k + 2) * static_cast<double>(k);
+    }
+    return reciprocal(k / 2 + 2) + 3 * mul(k + 1, k);
+  }
+
+  /// the limbs of first (first + 1) ... (last - 1)
+  static std::size_t product_limbs(const std::uint64_t first,
+                                   const std::uint64_t last) {
+    const double log = std::lgamma(static_cast<double>(last)) -
+                       std::lgamma(static_cast<double>(first));
+    return std::max<std::size_t>(1, limbs(log / LOG_BASE));
+  }
+
+  double product(const std::uint64_t first, // NOLINT recursion
+                 const std::uint64_t last) {
+    if (last - first <= PRODUCT_LEAF) {
+      return static_cast<double>(product_limbs(first, last));
+    }
+    const std::uint64_t mid = first + (last - first) / 2;
+    const std::size_t left = product_limbs(first, mid);
+    const std::size_t right = product_limbs(mid, last);
+    return product(first, mid) + product(mid, last) +
+           mul(std::max(left, right), std::min(left, right));
+  }
+
+  std::map<std::pair<std::size_t, std::size_t>, double> _mul;
+  std::map<std::size_t, double> _sqr;
+};
+
+/// @return the natural log of |x|, from its top two limbs
+[[nodiscard]] inline double log_abs(const BigInt &x) {
+  const Limbs &v = x.limbs();
+  double top = static_cast<double>(v.back());
+  std::size_t below = v.size() - 1;
+  if (below > 0) {
+    top = top * static_cast<double>(LIMB_BASE) +
+          static_cast<double>(v[below - 1]);
+    --below;
+  }
+  return std::log(top) + static_cast<double>(below) * LOG_BASE;
+}
+
+} // namespace detail
+
+namespace async {
+
+/**
+ * @class Future
+ * @brief The handle of an operation started by sch::async: its result, and
+ *        the means to cancel it and watch it progress.
+ */
+template <typename T> class Future {
+public:
+  Future() = default;
+
+  /**
+   * @brief Wait for the result.
+   * @throws OperationCancelled if the operation was cancelled before it
+   *         finished, or whatever else the operation threw.
+   */
+  T get() { return _future.get(); }
+
+  [[nodiscard]] bool valid() const { return _future.valid(); }
+  void wait() const { _future.wait(); }
+
+  template <typename Rep, typename Period>
+  std::future_status
+  wait_for(const std::chrono::duration<Rep, Period> &timeout) const {
+    return _future.wait_for(timeout);
+  }
+
+  template <typename Clock, typename Duration>
+  std::future_status
+  wait_until(const std::chrono::time_point<Clock, Duration> &deadline) const {
+    return _future.wait_until(deadline);
+  }
+
+  /// ask the operation to stop; it does at its next recursion boundary
+  void cancel() const { _token.cancel(); }
+
+  /// @return the estimated fraction done, 1 once the result is ready
+  [[nodiscard]] double progress() const {
+    return _operation ? _operation->progress() : 0;
+  }
+
+private:
+  template <typename F>
+  friend Future<BigInt> launch(F work, double total_work,
+                               CancellationToken token,
+                               ProgressCallback progress);
+
+  Future(std::future<T> future, CancellationToken token,
+         std::shared_ptr<detail::Operation> operation)
+      : _future{std::move(future)}, _token{std::move(token)},
+        _operation{std::move(operation)} {}
+
+  std::future<T> _future;
+  CancellationToken _token;
+  std::shared_ptr<detail::Operation> _operation;
+};
+
+/**
+ * @brief Start work() as an operation of `total_work` estimated limb products.
+ *        The building block of the functions below.
+ */
+template <typename F>
+Future<BigInt> launch(F work, const double total_work, CancellationToken token,
+                      ProgressCallback progress) {
+  auto operation = std::make_shared<detail::Operation>(
+      token, std::move(progress), total_work);
+  auto promise = std::make_shared<std::promise<BigInt>>();
+  Future<BigInt> future{promise->get_future(), std::move(token), operation};
+
+  auto task = [promise, operation, work = std::move(work)]() mutable {
+    try {
+      const detail::OperationScope scope{operation.get()};
+      detail::checkpoint(); // cancelled before it started
+      BigInt result = work();
+      operation->finish();
+      promise->set_value(std::move(result));
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  };
+  // a pool without workers would run the task inline, before we return
+  const std::shared_ptr<Executor> e = executor();
+  if (e->concurrency() > 1) {
+    e->submit(std::move(task));
+  } else {
+    std::thread{std::move(task)}.detach();
+  }
+  return future;
+}
+
+/// @return a * b, computed in the background
+inline Future<BigInt> mul(BigInt a, BigInt b, CancellationToken token = {},
+                          ProgressCallback progress = {}) {
+  detail::WorkEstimate estimate;
+  const std::size_t an = a.limbs().size();
+  const std::size_t bn = b.limbs().size();
+  const bool square = a.limbs() == b.limbs();
+  detail::check_mul(an, bn, square);
+  const double work = square
+                          ? estimate.sqr(an)
+                          : estimate.mul(std::max(an, bn), std::min(an, bn));
+  return launch([a = std::move(a), b = std::move(b)] { return a * b; }, work,
+                std::move(token), std::move(progress));
+}
+
+/**
+ * @return a / b, computed in the background
+ * @note get() throws std::runtime_error if `b` is zero
+ */
+inline Future<BigInt> div(BigInt a, BigInt b, CancellationToken token = {},
+                          ProgressCallback progress = {}) {
+  detail::check_div(a.limbs().size(), b.limbs().size());
+  const double work =
+      detail::WorkEstimate{}.div(a.limbs().size(), b.limbs().size());
+  return launch([a = std::move(a), b = std::move(b)] { return a / b; }, work,
+                std::move(token), std::move(progress));
+}
+
+/// @return base^exp, computed in the background
+inline Future<BigInt> pow(BigInt base, const std::uint64_t exp,
+                          CancellationToken token = {},
+                          ProgressCallback progress = {}) {
+  if (exp > 0 && !detail::is_zero(base.limbs())) {
+    detail::check_pow(base.limbs(), exp);
+  }
+  const double work =
+      detail::is_zero(base.limbs())
+          ? 0
+          : detail::WorkEstimate{}.pow(detail::log_abs(base), exp);
+  return launch([base = std::move(base), exp] { return sch::pow(base, exp); },
+                work, std::move(token), std::move(progress));
+}
+
+/// @return n!, computed in the background (and in parallel, on the pool)
+inline Future<BigInt> factorial(const std::uint64_t n,
+                                CancellationToken token = {},
+                                ProgressCallback progress = {}) {
+  if (detail::budget_active()) {
+    detail::check_limbs(
+        std::ceil(std::lgamma(static_cast<double>(n) + 1) / detail::LOG_BASE));
+  }
+  const double work = detail::WorkEstimate{}.factorial(n);
+  if (detail::budget_active()) {
+    detail::check_work(work);
+  }
+  return launch([n] { return sch::factorial(n); }, work, std::move(token),
+                std::move(progress));
+}
+
+} // namespace async
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_ASYNC_HPP_
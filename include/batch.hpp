@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file batch.hpp
+ * @brief Many independent operations of mixed sizes, scheduled together onto
+ *        the thread pool
+ *
+ * sch::batch::multiply, divide, pow and powm estimate each task's cost from
+ * its operand sizes (see async.hpp), then schedule them largest first:
+ * for multiply and pow, a task that costs more than an even share of the
+ * whole batch runs on its own with every thread the policy allows, splitting
+ * its products over them; the others are dealt one per thread, each free
+ * thread taking the largest task left, so that the small ones at the end fill
+ * in the gaps. A division or modular exponentiation has no parallel kernel,
+ * so every one of those is dealt this way, however large. Results come
+ * back in the order of the tasks. Every task is checked against the calling
+ * thread's budget (see budget.hpp) before any work starts.
+ *
+ * A task is anything `std::get` takes apart, e.g.
+ * `std::pair<const BigInt &, const BigInt &>`, and the tasks any range with
+ * random access.
+ */
+
+#ifndef SCH_INCLUDE_BATCH_HPP_
+#define SCH_INCLUDE_BATCH_HPP_
+
+#include "BigInt.hpp"
+#include "ModInt.hpp"
+#include "async.hpp"
+#include "limbs.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sch {
+
+namespace detail {
+
+/// below this many limbs in the smaller operand, a product stays on a thread
+inline constexpr std::size_t PAR_MUL_THRESHOLD = 1024;
+
+/**
+ * r[0..an+bn) = a[0..an) * b[0..bn), an >= bn, with the top `depth` levels of
+ * Karatsuba's recursion running their subproducts concurrently; a square
+ * (a == b, an == bn) stays a square all the way down
+ */
+inline void mul_parallel(std::uint64_t *r, // NOLINT recursion
+                         const std::uint64_t *a, const std::size_t an,
+                         const std::uint64_t *b, const std::size_t bn,
+                         const unsigned depth) {
+  const bool square = a == b && an == bn;
+  if (depth == 0 || bn < PAR_MUL_THRESHOLD) {
+    if (square) {
+      sqr_karatsuba(r, a, an);
+    } else {
+      mul_karatsuba(r, a, an, b, bn);
+    }
+    return;
+  }
+
+  const std::size_t h = (an + 1) / 2;
+  if (bn <= h) {
+    // unbalanced: the two halves of a times b
+    const std::size_t an1 = an - h;
+    Limbs hi(an1 + bn);
+    parallel_invoke([&] { mul_parallel(r, a, h, b, bn, depth - 1); },
+                    [&] {
+                      if (an1 >= bn) {
+                        mul_parallel(hi.data(), a + h, an1, b, bn, depth - 1);
+                      } else {
+                        mul_parallel(hi.data(), b, bn, a + h, an1, depth - 1);
+                      }
+                    });
+    std::fill(r + h + bn, r + an + bn, 0);
+    add_n(r + h, r + h, hi.data(), an1 + bn);
+    return;
+  }
+
+  // as in mul_karatsuba
+  const std::size_t an1 = an - h;
+  const std::size_t bn1 = bn - h;
+  Limbs sa(h + 1, 0); // a0 + a1
+  std::copy(a + an1, a + h, sa.begin() + static_cast<std::ptrdiff_t>(an1));
+  sa[h] = add_1(sa.data() + an1, h - an1, add_n(sa.data(), a, a + h, an1));
+  Limbs sb; // b0 + b1
+  if (!square) {
+    sb.assign(h + 1, 0);
+    std::copy(b + bn1, b + h, sb.begin() + static_cast<std::ptrdiff_t>(bn1));
+    sb[h] = add_1(sb.data() + bn1, h - bn1, add_n(sb.data(), b, b + h, bn1));
+  }
+  const std::uint64_t *const s = square ? sa.data() : sb.data();
+
+  Limbs z1(2 * h + 2);
+  {
+    TaskGroup group;
+    group.run(
+        [&] { mul_parallel(r + 2 * h, a + h, an1, b + h, bn1, depth - 1); });
+    group.run([&] {
+      mul_parallel(z1.data(), sa.data(), h + 1, s, h + 1, depth - 1);
+    });
+    group.run_here([&] { mul_parallel(r, a, h, b, h, depth - 1); });
+    group.wait();
+  }
+
+  sub_1(z1.data() + 2 * h, 2, sub_n(z1.data(), z1.data(), r, 2 * h));
+  const std::size_t n2 = an1 + bn1;
+  sub_1(z1.data() + n2, z1.size() - n2,
+        sub_n(z1.data(), z1.data(), r + 2 * h, n2));
+  const std::size_t n1 = std::min(z1.size(), an + bn - h);
+  const std::uint64_t carry = add_n(r + h, r + h, z1.data(), n1);
+  add_1(r + h + n1, an + bn - h - n1, carry);
+}
+
+/// @return the levels of parallel recursion that keep `threads` busy
+[[nodiscard]] inline unsigned parallel_depth(const unsigned threads) {
+  unsigned depth = 0;
+  for (unsigned tasks = 1; tasks < 2 * threads; tasks *= 3) {
+    ++depth;
+  }
+  return threads <= 1 ? 0 : depth;
+}
+
+/// @return a * b on the threads the policy allows
+[[nodiscard]] inline BigInt mul_parallel(const BigInt &a, const BigInt &b,
+                                         const ExecutionPolicy policy) {
+  const unsigned depth = parallel_depth(policy.concurrency());
+  if (depth == 0 || std::min(a.limbs().size(), b.limbs().size()) <
+                        PAR_MUL_THRESHOLD) {
+    return a * b;
+  }
+  const bool swap = a.limbs().size() < b.limbs().size();
+  const Limbs &big = swap ? b.limbs() : a.limbs();
+  const Limbs &small = swap ? a.limbs() : b.limbs();
+  Limbs r(big.size() + small.size(), 0);
+  const ThreadCap cap{policy};
+  mul_parallel(r.data(), big.data(), big.size(), small.data(), small.size(),
+               depth);
+  trim(r);
+  BigInt product{std::move(r)};
+  return (a < 0) != (b < 0) ? -std::move(product) : product;
+}
+
+/// @return base^exp by squaring, the products on the threads the policy allows
+[[nodiscard]] inline BigInt pow_parallel(BigInt base, std::uint64_t exp,
+                                         const ExecutionPolicy policy) {
+  BigInt res{1};
+  while (exp > 0) {
+    if (exp % 2 == 1) {
+      res = mul_parallel(res, base, policy);
+    }
+    exp /= 2;
+    if (exp > 0) {
+      base = mul_parallel(base, base, policy);
+    }
+  }
+  return res;
+}
+
+/// @return the index of every task, most costly first
+[[nodiscard]] inline std::vector<std::size_t>
+largest_first(const std::vector<double> &cost) {
+  std::vector<std::size_t> order(cost.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&cost](const std::size_t i, const std::size_t j) {
+                     return cost[i] > cost[j];
+                   });
+  return order;
+}
+
+/**
+ * run(i, policy) for every task i, on one thread each, largest first (LPT
+ * list scheduling); if run splits a task over the threads of its policy
+ * (`splits`), those costing more than an even share of the total run first,
+ * alone with the whole policy
+ */
+template <typename F>
+void schedule(const std::vector<double> &cost, const F &run,
+              const ExecutionPolicy policy, const bool splits) {
+  const std::vector<std::size_t> order = largest_first(cost);
+  const unsigned threads = policy.concurrency();
+  if (threads <= 1) {
+    for (const std::size_t i : order) {
+      run(i, seq);
+    }
+    return;
+  }
+
+  const double share =
+      std::accumulate(cost.begin(), cost.end(), 0.0) / threads;
+  std::size_t first = 0;
+  for (; splits && first < order.size() && cost[order[first]] > share;
+       ++first) {
+    run(order[first], policy);
+  }
+
+  std::atomic<std::size_t> next{first};
+  const auto worker = [&] {
+    for (std::size_t k = next++; k < order.size(); k = next++) {
+      run(order[k], seq);
+    }
+  };
+  const std::size_t helpers =
+      std::min<std::size_t>(threads, order.size() - first);
+  TaskGroup group{policy};
+  for (std::size_t t = 1; t < helpers; ++t) {
+    group.run(worker);
+  }
+  group.run_here(worker);
+  group.wait();
+}
+
+/// @return the work of one modular exponentiation, log_exp = log |exp|
+[[nodiscard]] inline double powm_work(WorkEstimate &estimate,
+                                      const std::size_t k,
+                                      const double log_exp) {
+  // a square and a reduction per bit, a multiplication for about half of them
+  const double bits = std::max(log_exp / std::log(2.0), 1.0);
+  return bits * (estimate.sqr(k) + 2.5 * estimate.mul(k, k));
+}
+
+} // namespace detail
+
+namespace batch {
+
+/**
+ * @param tasks pairs (a, b)
+ * @return a * b for each pair, in order
+ */
+template <typename Range>
+[[nodiscard]] std::vector<BigInt> multiply(const Range &tasks,
+                                           const ExecutionPolicy policy = par) {
+  const auto first = std::begin(tasks);
+  const auto n =
+      static_cast<std::size_t>(std::distance(first, std::end(tasks)));
+  detail::WorkEstimate estimate;
+  std::vector<double> cost(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t an = std::get<0>(first[i]).limbs().size();
+    const std::size_t bn = std::get<1>(first[i]).limbs().size();
+    detail::check_mul(an, bn);
+    cost[i] = 1 + estimate.mul(std::max(an, bn), std::min(an, bn));
+  }
+  std::vector<BigInt> result(n);
+  detail::schedule(
+      cost,
+      [&](const std::size_t i, const ExecutionPolicy p) {
+        result[i] = detail::mul_parallel(std::get<0>(first[i]),
+                                         std::get<1>(first[i]), p);
+      },
+      policy, true);
+  return result;
+}
+
+/**
+ * @param tasks pairs (a, b)
+ * @return (a / b, a % b) for each pair, in order, as BigInt's operators give
+ *         them
+ * @throws std::runtime_error if any b is zero, before any work starts.
+ */
+template <typename Range>
+[[nodiscard]] std::vector<std::pair<BigInt, BigInt>>
+divide(const Range &tasks, const ExecutionPolicy policy = par) {
+  const auto first = std::begin(tasks);
+  const auto n =
+      static_cast<std::size_t>(std::distance(first, std::end(tasks)));
+  detail::WorkEstimate estimate;
+  std::vector<double> cost(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const BigInt &b = std::get<1>(first[i]);
+    if (b == 0) {
+      throw std::runtime_error(
+          "sch::batch::divide() : Division by zero is undefined");
+    }
+    const std::size_t an = std::get<0>(first[i]).limbs().size();
+    detail::check_div(an, b.limbs().size());
+    cost[i] = 1 + static_cast<double>(an) +
+              estimate.div(an, b.limbs().size());
+  }
+  std::vector<std::pair<BigInt, BigInt>> result(n);
+  detail::schedule(
+      cost,
+      [&](const std::size_t i, ExecutionPolicy) {
+        const BigInt &a = std::get<0>(first[i]);
+        const BigInt &b = std::get<1>(first[i]);
+        if (a == 0) {
+          result[i] = {BigInt{0}, BigInt{0}};
+          return;
+        }
+        detail::Limbs q;
+        detail::Limbs r;
+        detail::divmod(a.limbs(), b.limbs(), q, r);
+        BigInt quotient{std::move(q)};
+        BigInt remainder{std::move(r)};
+        result[i].first =
+            (a < 0) != (b < 0) ? -std::move(quotient) : std::move(quotient);
+        result[i].second = a < 0 ? -std::move(remainder) : std::move(remainder);
+      },
+      policy, false);
+  return result;
+}
+
+/**
+ * @param tasks pairs (base, exp), exp a non-negative built-in integer
+ * @return base^exp for each pair, in order
+ * @throws std::invalid_argument if any exp is negative, before any work
+ *         starts.
+ */
+template <typename Range>
+[[nodiscard]] std::vector<BigInt> pow(const Range &tasks,
+                                      const ExecutionPolicy policy = par) {
+  const auto first = std::begin(tasks);
+  const auto n =
+      static_cast<std::size_t>(std::distance(first, std::end(tasks)));
+  detail::WorkEstimate estimate;
+  std::vector<double> cost(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const BigInt &base = std::get<0>(first[i]);
+    const auto exp = std::get<1>(first[i]);
+    if constexpr (std::is_signed_v<decltype(exp)>) {
+      if (exp < 0) {
+        throw std::invalid_argument("sch::batch::pow() : negative exponent");
+      }
+    }
+    if (exp > 0 && base != 0) {
+      detail::check_pow(base.limbs(), static_cast<std::uint64_t>(exp));
+    }
+    cost[i] = 1 + (base == 0 ? 0
+                             : estimate.pow(detail::log_abs(base),
+                                            static_cast<std::uint64_t>(exp)));
+  }
+  std::vector<BigInt> result(n);
+  detail::schedule(
+      cost,
+      [&](const std::size_t i, const ExecutionPolicy p) {
+        const BigInt &base = std::get<0>(first[i]);
+        const auto exp = static_cast<std::uint64_t>(std::get<1>(first[i]));
+        result[i] = exp == 0 ? BigInt{1} : detail::pow_parallel(base, exp, p);
+      },
+      policy, true);
+  return result;
+}
+
+/**
+ * @param tasks triples (base, exp, mod) of BigInts
+ * @return base^exp mod mod, in [0, mod), for each triple, in order
+ * @throws std::invalid_argument if any exp is negative or any mod is less
+ *         than 2, before any work starts.
+ */
+template <typename Range>
+[[nodiscard]] std::vector<BigInt> powm(const Range &tasks,
+                                       const ExecutionPolicy policy = par) {
+  const auto first = std::begin(tasks);
+  const auto n =
+      static_cast<std::size_t>(std::distance(first, std::end(tasks)));
+  detail::WorkEstimate estimate;
+  std::vector<double> cost(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const BigInt &exp = std::get<1>(first[i]);
+    const BigInt &mod = std::get<2>(first[i]);
+    if (exp < 0) {
+      throw std::invalid_argument("sch::batch::powm() : negative exponent");
+    }
+    if (mod < 2) {
+      throw std::invalid_argument(
+          "sch::batch::powm() : modulus must be greater than 1");
+    }
+    const double work = detail::powm_work(
+        estimate, mod.limbs().size(), exp == 0 ? 0 : detail::log_abs(exp));
+    if (detail::budget_active()) { // the results are below the modulus
+      detail::check_limbs(static_cast<double>(mod.limbs().size()));
+      detail::check_work(work);
+    }
+    cost[i] = 1 + work;
+  }
+  std::vector<BigInt> result(n);
+  detail::schedule(
+      cost,
+      [&](const std::size_t i, ExecutionPolicy) {
+        const ModContext context{std::get<2>(first[i])};
+        result[i] = context.pow(std::get<0>(first[i]), std::get<1>(first[i]));
+      },
+      policy, false);
+  return result;
+}
+
+} // namespace batch
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_BATCH_HPP_
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file budget.hpp
+ * @brief Resource budgets for operations on untrusted input
+ *
+ * A Budget caps the decimal digits of a parsed string, the limbs of any
+ * result, and the estimated cost of a single operation, in limb products.
+ * Parsing, multiplication (with fma), division, modulo, pow and divexact
+ * check the budget installed on the calling thread before they do any work
+ * and throw BudgetExceeded if the operation would go over it, so an
+ * oversized request fails in microseconds instead of running for minutes or
+ * exhausting memory. sch::async and sch::batch check each operation on the
+ * calling thread before handing it to another.
+ *
+ * The budget is per thread: set_thread_budget() installs one until it is
+ * replaced, a BudgetScope installs one for the calls made within it (a
+ * single request, say) and restores the previous one on exit. Without a
+ * budget a check is one thread-local load.
+ *
+ * The cost is an estimate from the operand sizes and the algorithm the
+ * kernels pick for them: n m limb products for schoolbook multiplication,
+ * growing as n^log2(3) once Karatsuba takes over, and for division the
+ * schoolbook or Newton cost. It follows the kernels' actual work to within
+ * a small factor, which is all a limit needs; a wall-clock deadline is
+ * sch::async's wait_until() followed by cancel().
+ */
+
+#ifndef SCH_INCLUDE_BUDGET_HPP_
+#define SCH_INCLUDE_BUDGET_HPP_
+
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace sch {
+
+/// the resources a Budget limits
+enum class Resource : std::uint8_t {
+  digits, ///< decimal digits of a parsed string
+  limbs,  ///< limbs of a result
+  work,   ///< estimated limb products of one operation
+};
+
+/**
+ * @struct Budget
+ * @brief Limits on the size and cost of operations; each is unlimited by
+ *        default.
+ */
+struct Budget {
+  static constexpr std::size_t UNLIMITED =
+      std::numeric_limits<std::size_t>::max();
+
+  std::size_t max_digits = UNLIMITED; ///< digits of a parsed string
+  std::size_t max_limbs = UNLIMITED;  ///< limbs of any result
+  double max_work = std::numeric_limits<double>::infinity(); ///< per operation
+
+  [[nodiscard]] bool unlimited() const {
+    return max_digits == UNLIMITED && max_limbs == UNLIMITED &&
+           max_work == std::numeric_limits<double>::infinity();
+  }
+};
+
+/// thrown, before any work is done, by an operation over its thread's budget
+class BudgetExceeded : public std::runtime_error {
+public:
+  BudgetExceeded(const Resource resource, const double needed,
+                 const double limit)
+      : std::runtime_error{message(resource, needed, limit)},
+        _resource{resource}, _needed{needed}, _limit{limit} {}
+
+  [[nodiscard]] Resource resource() const { return _resource; }
+  /// @return the (estimated) amount the operation needs
+  [[nodiscard]] double needed() const { return _needed; }
+  [[nodiscard]] double limit() const { return _limit; }
+
+private:
+  static std::string message(const Resource resource, const double needed,
+                             const double limit) {
+    static constexpr const char *names[] = {"digits", "limbs", "work"};
+    std::ostringstream os;
+    os << "sch: budget exceeded: " << needed << ' '
+       << names[static_cast<std::size_t>(resource)] << " needed, limit "
+       << limit;
+    return os.str();
+  }
+
+  Resource _resource;
+  double _needed;
+  double _limit;
+};
+
+namespace detail {
+
+/// the budget of this thread, and whether it limits anything
+struct ThreadBudget {
+  Budget budget;
+  bool active = false;
+};
+
+inline thread_local ThreadBudget thread_budget_state{};
+
+} // namespace detail
+
+/// install `budget` on the calling thread; Budget{} removes every limit
+inline void set_thread_budget(const Budget &budget) {
+  detail::thread_budget_state = {budget, !budget.unlimited()};
+}
+
+/// @return the budget of the calling thread
+[[nodiscard]] inline Budget thread_budget() {
+  return detail::thread_budget_state.budget;
+}
+
+/**
+ * @class BudgetScope
+ * @brief Installs a budget on the calling thread for its lifetime, then
+ *        restores the previous one.
+ */
+class BudgetScope {
+public:
+  explicit BudgetScope(const Budget &budget) : _saved{thread_budget()} {
+    set_thread_budget(budget);
+  }
+  ~BudgetScope() { set_thread_budget(_saved); }
+  BudgetScope(const BudgetScope &) = delete;
+  BudgetScope &operator=(const BudgetScope &) = delete;
+
+private:
+  Budget _saved;
+};
+
+namespace detail {
+
+// COST ESTIMATES --------------------------------------------------------------
+// limb products, from the operand sizes and the kernels' algorithm tiers
+
+inline constexpr double LOG2_3 = 1.584962500721156;
+inline constexpr double LIMB_DIGITS = 18; ///< decimal digits per limb
+
+/// @return the estimated cost of mul() on an x bn limbs
+[[nodiscard]] inline double mul_cost(std::size_t an, std::size_t bn) {
+  if (an < bn) {
+    std::swap(an, bn);
+  }
+  if (bn < KARATSUBA_THRESHOLD) {
+    return static_cast<double>(an) * static_cast<double>(bn);
+  }
+  // ceil(an / bn) Karatsuba products of bn x bn limbs
+  const auto t = static_cast<double>(KARATSUBA_THRESHOLD);
+  const double blocks = std::ceil(static_cast<double>(an) / bn);
+  return blocks * t * t * std::pow(static_cast<double>(bn) / t, LOG2_3);
+}
+
+/// @return the estimated cost of sqr() on n limbs
+[[nodiscard]] inline double sqr_cost(const std::size_t n) {
+  const auto t = static_cast<double>(KARATSUBA_THRESHOLD);
+  if (n < KARATSUBA_THRESHOLD) {
+    return static_cast<double>(n) * static_cast<double>(n + 1) / 2;
+  }
+  return t * (t + 1) / 2 * std::pow(static_cast<double>(n) / t, LOG2_3);
+}
+
+/// @return the estimated cost of divmod() of an by bn limbs
+[[nodiscard]] inline double div_cost(const std::size_t an,
+                                     const std::size_t bn) {
+  if (bn < 2 || an < bn) {
+    return static_cast<double>(an);
+  }
+  if (bn < DIV_NEWTON_THRESHOLD) {
+    return static_cast<double>(an - bn + 1) * static_cast<double>(bn);
+  }
+  // the reciprocal, about 4.5 products of bn limbs over Newton's steps, then
+  // three products per bn-limb chunk of the dividend
+  const double chunks = std::ceil(static_cast<double>(an) / bn);
+  return (4.5 + 3 * chunks) * mul_cost(bn, bn);
+}
+
+/// @return log_BASE |x|, in limbs, for x != 0
+[[nodiscard]] inline double log_limbs(const Limbs &x) {
+  return static_cast<double>(x.size() - 1) +
+         std::log(static_cast<double>(x.back())) /
+             std::log(static_cast<double>(LIMB_BASE));
+}
+
+// CHECKS ----------------------------------------------------------------------
+
+[[nodiscard]] inline bool budget_active() { return thread_budget_state.active; }
+
+inline void check_limbs(const double limbs) {
+  const Budget &b = thread_budget_state.budget;
+  if (limbs > static_cast<double>(b.max_limbs)) {
+    throw BudgetExceeded{Resource::limbs, limbs,
+                         static_cast<double>(b.max_limbs)};
+  }
+}
+
+inline void check_work(const double work) {
+  const Budget &b = thread_budget_state.budget;
+  if (work > b.max_work) {
+    throw BudgetExceeded{Resource::work, work, b.max_work};
+  }
+}
+
+/// parsing `digits` decimal digits
+inline void check_parse(const std::size_t digits) {
+  if (!budget_active()) {
+    return;
+  }
+  const Budget &b = thread_budget_state.budget;
+  if (digits > b.max_digits) {
+    throw BudgetExceeded{Resource::digits, static_cast<double>(digits),
+                         static_cast<double>(b.max_digits)};
+  }
+  check_limbs(std::ceil(static_cast<double>(digits) / LIMB_DIGITS));
+}
+
+/// an an x bn limb product, or a square
+inline void check_mul(const std::size_t an, const std::size_t bn,
+                      const bool square = false) {
+  if (!budget_active()) {
+    return;
+  }
+  check_limbs(static_cast<double>(an) + static_cast<double>(bn));
+  check_work(square ? sqr_cost(an) : mul_cost(an, bn));
+}
+
+/// a division of an by bn limbs
+inline void check_div(const std::size_t an, const std::size_t bn) {
+  if (budget_active()) {
+    check_work(div_cost(an, bn));
+  }
+}
+
+/// base^exp, base nonzero, by repeated squaring
+inline void check_pow(const Limbs &base, const std::uint64_t exp) {
+  if (!budget_active()) {
+    return;
+  }
+  const double per_power = log_limbs(base);
+  check_limbs(std::ceil(per_power * static_cast<double>(exp)));
+  const auto limbs = [](const double x) {
+    return static_cast<std::size_t>(std::max(1.0, std::ceil(x)));
+  };
+  double work = 0;
+  double done = 0;  // the exponent of the result so far
+  double power = 1; // the exponent of the current square
+  for (std::uint64_t e = exp; e > 0; e /= 2, power *= 2) {
+    const std::size_t square = limbs(per_power * power);
+    if (e % 2 == 1) {
+      work += mul_cost(limbs(per_power * done), square);
+      done += power;
+    }
+    if (e > 1) {
+      work += sqr_cost(square);
+    }
+  }
+  check_work(work);
+}
+
+} // namespace detail
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_BUDGET_HPP_
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file cache.hpp
+ * @brief A thread-safe cache of powers and other constants that operations
+ *        keep needing
+ *
+ * constants() is the process-wide ConstantCache. It holds powers radix^k
+ * (random_bits() in random.hpp draws below cached powers of 2), factorials
+ * and primorials, each computed on first use and shared as a
+ * `std::shared_ptr<const BigInt>`.
+ *
+ * Lookups take no lock: the table is a fixed array of atomic pointers probed
+ * linearly, entries are published with a compare-and-swap and never change
+ * afterwards. clear() unpublishes every entry and frees it once the lookups
+ * that might still be reading it have finished; values already handed out
+ * live on in their shared_ptr. Past the memory limit, or once the probe runs
+ * into a full neighbourhood, values are computed but no longer kept.
+ */
+
+#ifndef SCH_INCLUDE_CACHE_HPP_
+#define SCH_INCLUDE_CACHE_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sch {
+
+namespace detail {
+
+/// @return the product of `factors`, as a balanced tree
+[[nodiscard]] inline BigInt product_of(std::vector<std::uint64_t> factors) {
+  // gather factors in one word while the run stays below a limb
+  std::vector<BigInt> level;
+  std::uint64_t run = 1;
+  for (const std::uint64_t k : factors) {
+    if (run > (BigInt::BASE - 1) / k) {
+      level.emplace_back(run);
+      run = 1;
+    }
+    run *= k;
+  }
+  level.emplace_back(run);
+  while (level.size() > 1) {
+    std::vector<BigInt> next;
+    for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+      next.push_back(level[i] * level[i + 1]);
+    }
+    if (level.size() % 2 == 1) {
+      next.push_back(std::move(level.back()));
+    }
+    level = std::move(next);
+  }
+  return std::move(level.front());
+}
+
+} // namespace detail
+
+/**
+ * @class ConstantCache
+ * @brief Lazily computed powers, factorials and primorials, safe to share
+ *        between threads.
+ */
+class ConstantCache {
+public:
+  /// the default memory limit, in limbs (32 MiB)
+  static constexpr std::size_t DEFAULT_LIMIT = std::size_t{1} << 22U;
+
+  ConstantCache() = default;
+  ~ConstantCache() { clear(); }
+  ConstantCache(const ConstantCache &) = delete;
+  ConstantCache &operator=(const ConstantCache &) = delete;
+
+  /// @return radix^k
+  [[nodiscard]] std::shared_ptr<const BigInt> power(const std::uint64_t radix,
+                                                    const std::uint64_t k) {
+    return get({Kind::power, radix, k}, [this, radix, k] {
+      // powers with exponents 2^j build on each other, as divide-and-conquer
+      // algorithms use them
+      if (k >= 2 && (k & (k - 1)) == 0) {
+        const std::shared_ptr<const BigInt> half = power(radix, k / 2);
+        return *half * *half;
+      }
+      return pow(BigInt{radix}, k);
+    });
+  }
+
+  /// @return n!
+  [[nodiscard]] std::shared_ptr<const BigInt>
+  factorial(const std::uint64_t n) {
+    return get({Kind::factorial, n, 0}, [n] {
+      std::vector<std::uint64_t> factors;
+      for (std::uint64_t k = 2; k <= n; ++k) {
+        factors.push_back(k);
+      }
+      return detail::product_of(std::move(factors));
+    });
+  }
+
+  /// @return n#, the product of the primes up to n
+  [[nodiscard]] std::shared_ptr<const BigInt>
+  primorial(const std::uint64_t n) {
+    return get({Kind::primorial, n, 0}, [n] {
+      std::vector<bool> composite(n + 1, false);
+      std::vector<std::uint64_t> primes;
+      for (std::uint64_t k = 2; k <= n; ++k) {
+        if (composite[k]) {
+          continue;
+        }
+        primes.push_back(k);
+        for (std::uint64_t j = k * k; j <= n; j += k) {
+          composite[j] = true;
+        }
+      }
+      return detail::product_of(std::move(primes));
+    });
+  }
+
+  /// keep at most `limbs` limbs of values from now on; clear() to shrink
+  void set_memory_limit(const std::size_t limbs) {
+    _limit.store(limbs, std::memory_order_relaxed);
+  }
+  [[nodiscard]] std::size_t memory_limit() const {
+    return _limit.load(std::memory_order_relaxed);
+  }
+  /// @return the limbs of the values kept
+  [[nodiscard]] std::size_t memory() const {
+    return _memory.load(std::memory_order_relaxed);
+  }
+  /// @return the number of values kept
+  [[nodiscard]] std::size_t size() const {
+    return _size.load(std::memory_order_relaxed);
+  }
+
+  /// forget every value, freeing those no caller still holds
+  void clear() {
+    const std::lock_guard lock{_clear_mutex};
+    std::vector<Node *> removed;
+    for (std::atomic<Node *> &slot : _slots) {
+      if (Node *const node = slot.exchange(nullptr)) {
+        removed.push_back(node);
+      }
+    }
+    // lookups from now on count on the other counter and cannot see the
+    // removed nodes; wait out those that might
+    const unsigned old = _epoch.fetch_xor(1);
+    while (_readers[old].load() != 0) {
+      std::this_thread::yield();
+    }
+    for (Node *const node : removed) {
+      _memory.fetch_sub(node->value->limbs().size());
+      _size.fetch_sub(1);
+      delete node; // NOLINT(cppcoreguidelines-owning-memory)
+    }
+  }
+
+private:
+  enum class Kind : std::uint8_t { power, factorial, primorial };
+
+  struct Key {
+    Kind kind;
+    std::uint64_t a;
+    std::uint64_t b;
+
+    bool operator==(const Key &rhs) const {
+      return kind == rhs.kind && a == rhs.a && b == rhs.b;
+    }
+  };
+
+  struct Node {
+    Key key;
+    std::shared_ptr<const BigInt> value;
+  };
+
+  static constexpr std::size_t SLOTS = 4096; ///< a power of two
+  static constexpr std::size_t PROBES = 16;  ///< slots tried per key
+
+  [[nodiscard]] static std::size_t hash(const Key &key) {
+    std::uint64_t h = key.a * 0x9e3779b97f4a7c15U;
+    h ^= (key.b + static_cast<std::uint64_t>(key.kind)) * 0xc2b2ae3d27d4eb4fU;
+    return static_cast<std::size_t>(h ^ (h >> 29U));
+  }
+
+  /**
+   * counts a lookup in progress on the current epoch's counter; if clear()
+   * flips the epoch between the load and the count, the count may be on a
+   * counter it no longer waits for, so it moves to the new one
+   */
+  class ReadScope {
+  public:
+    explicit ReadScope(const ConstantCache &cache) {
+      for (;;) {
+        const unsigned epoch = cache._epoch.load();
+        _counter = &cache._readers[epoch];
+        _counter->fetch_add(1);
+        if (cache._epoch.load() == epoch) {
+          return;
+        }
+        _counter->fetch_sub(1);
+      }
+    }
+    ~ReadScope() { _counter->fetch_sub(1); }
+    ReadScope(const ReadScope &) = delete;
+    ReadScope &operator=(const ReadScope &) = delete;
+
+  private:
+    std::atomic<std::size_t> *_counter = nullptr;
+  };
+
+  template <typename Compute>
+  std::shared_ptr<const BigInt> get(const Key &key, const Compute &compute) {
+    const std::size_t first = hash(key);
+    {
+      const ReadScope scope{*this};
+      for (std::size_t i = 0; i < PROBES; ++i) {
+        const Node *const node = _slots[(first + i) % SLOTS].load();
+        if (node == nullptr) {
+          break;
+        }
+        if (node->key == key) {
+          return node->value;
+        }
+      }
+    }
+
+    auto value = std::make_shared<const BigInt>(compute());
+    const std::size_t limbs = value->limbs().size();
+    if (_memory.fetch_add(limbs) + limbs > memory_limit()) {
+      _memory.fetch_sub(limbs);
+      return value;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto *node = new Node{key, value};
+    const ReadScope scope{*this};
+    for (std::size_t i = 0; i < PROBES; ++i) {
+      std::atomic<Node *> &slot = _slots[(first + i) % SLOTS];
+      Node *expected = nullptr;
+      if (slot.compare_exchange_strong(expected, node)) {
+        _size.fetch_add(1);
+        return value;
+      }
+      if (expected->key == key) { // another thread got there first
+        std::shared_ptr<const BigInt> found = expected->value;
+        _memory.fetch_sub(limbs);
+        delete node; // NOLINT(cppcoreguidelines-owning-memory)
+        return found;
+      }
+    }
+    _memory.fetch_sub(limbs); // no room near its hash: keep nothing
+    delete node;              // NOLINT(cppcoreguidelines-owning-memory)
+    return value;
+  }
+
+  std::array<std::atomic<Node *>, SLOTS> _slots{};
+  mutable std::array<std::atomic<std::size_t>, 2> _readers{};
+  std::atomic<unsigned> _epoch{0};
+  std::atomic<std::size_t> _memory{0};
+  std::atomic<std::size_t> _size{0};
+  std::atomic<std::size_t> _limit{DEFAULT_LIMIT};
+  std::mutex _clear_mutex;
+};
+
+/// @return the process-wide cache of constants
+[[nodiscard]] inline ConstantCache &constants() {
+  static ConstantCache cache;
+  return cache;
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_CACHE_HPP_
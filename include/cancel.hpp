@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file cancel.hpp
+ * @brief Cancellation and progress for long-running operations
+ *
+ * An operation started through the sch::async API is installed on the thread
+ * that runs it (and on the pool threads it forks to). The multiplication and
+ * division kernels call detail::checkpoint() at their recursion boundaries
+ * with the work they are about to do, counted in limb products; that is where
+ * a cancelled operation throws OperationCancelled and where progress is
+ * reported. Outside an operation a checkpoint is one thread-local load.
+ */
+
+#ifndef SCH_INCLUDE_CANCEL_HPP_
+#define SCH_INCLUDE_CANCEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace sch {
+
+/// thrown out of an operation whose CancellationToken was cancelled
+class OperationCancelled : public std::runtime_error {
+public:
+  OperationCancelled() : std::runtime_error{"sch: operation cancelled"} {}
+};
+
+/**
+ * @class CancellationToken
+ * @brief A shared flag: copies refer to the same flag, so one cancel() stops
+ *        every operation that was given a copy.
+ */
+class CancellationToken {
+public:
+  CancellationToken() = default;
+
+  void cancel() const noexcept {
+    _flag->store(true, std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool cancelled() const noexcept {
+    return _flag->load(std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> _flag =
+      std::make_shared<std::atomic<bool>>(false);
+};
+
+/**
+ * Called with the estimated fraction done, in [0, 1], on the thread doing the
+ * work; at most about once per percent, and with exactly 1 on success.
+ */
+using ProgressCallback = std::function<void(double)>;
+
+namespace detail {
+
+/// the cancellation and progress state of one running operation
+class Operation {
+public:
+  /// @param total_work The estimated limb products of the whole operation.
+  Operation(CancellationToken token, ProgressCallback callback,
+            const double total_work)
+      : _token{std::move(token)}, _callback{std::move(callback)},
+        _total{std::max(total_work, 1.0)} {}
+
+  /// @throws OperationCancelled if the token was cancelled
+  void checkpoint(const std::uint64_t work) {
+    if (_token.cancelled()) {
+      throw OperationCancelled{};
+    }
+    if (work == 0) {
+      return;
+    }
+    const std::uint64_t done =
+        _done.fetch_add(work, std::memory_order_relaxed) + work;
+    // an estimate can fall short: only finish() reports the end
+    report(std::min(static_cast<double>(done) / _total, 0.99));
+  }
+
+  void finish() { report(1.0); }
+
+  [[nodiscard]] double progress() const {
+    return _progress.load(std::memory_order_relaxed);
+  }
+
+private:
+  void report(const double fraction) {
+    double seen = _progress.load(std::memory_order_relaxed);
+    while (seen < fraction && !_progress.compare_exchange_weak(
+                                  seen, fraction, std::memory_order_relaxed)) {
+    }
+    if (!_callback || fraction < _next_report.load(std::memory_order_relaxed)) {
+      return;
+    }
+    const std::lock_guard lock{_callback_mutex};
+    if (fraction >= _next_report.load(std::memory_order_relaxed)) {
+      _next_report.store(fraction >= 1.0 ? 2.0 : fraction + 0.01,
+                         std::memory_order_relaxed);
+      _callback(fraction);
+    }
+  }
+
+  CancellationToken _token;
+  ProgressCallback _callback;
+  double _total;
+  std::atomic<std::uint64_t> _done{0};
+  std::atomic<double> _progress{0};
+  std::atomic<double> _next_report{0};
+  std::mutex _callback_mutex; ///< one callback at a time
+};
+
+/// the operation the calling thread works for, if any
+inline thread_local Operation *current_operation = nullptr;
+
+/**
+ * A recursion boundary of a kernel about to do `work` limb products.
+ * @throws OperationCancelled if the current operation was cancelled
+ */
+inline void checkpoint(const std::uint64_t work = 0) {
+  if (Operation *const op = current_operation) {
+    op->checkpoint(work);
+  }
+}
+
+/// makes `op` the current operation of this thread for the scope
+class OperationScope {
+public:
+  explicit OperationScope(Operation *const op)
+      : _previous{std::exchange(current_operation, op)} {}
+  ~OperationScope() { current_operation = _previous; }
+  OperationScope(const OperationScope &) = delete;
+  OperationScope &operator=(const OperationScope &) = delete;
+
+private:
+  Operation *_previous;
+};
+
+} // namespace detail
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_CANCEL_HPP_
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file digits.hpp
+ * @brief Decimal digits produced incrementally, for streaming a result while
+ *        the rest of it is still being computed
+ *
+ * A DigitGenerator hands out the digits of a number from the most significant
+ * down, one chunk per next(), each chunk as soon as it is final: the digits of
+ * an existing BigInt, of a product computed a block of the multiplier at a
+ * time, of sqrt(n) or of pi and e at doubling precision. Concatenated, the
+ * chunks are the number's decimal representation.
+ */
+
+#ifndef SCH_INCLUDE_DIGITS_HPP_
+#define SCH_INCLUDE_DIGITS_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+#include "series.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace sch {
+
+/**
+ * @class DigitGenerator
+ * @brief A pull-based generator of chunks of decimal digits.
+ *
+ * Call next() until it returns nothing, or iterate over the chunks with a
+ * range-for. Generators of irrational numbers never end; stop pulling when
+ * you have enough.
+ */
+class DigitGenerator {
+public:
+  /// produces the next chunk, or nothing once the digits are exhausted
+  using Source = std::function<std::optional<std::string>()>;
+
+  explicit DigitGenerator(Source source) : _source{std::move(source)} {}
+
+  /// @return the next chunk of digits, or nothing at the end
+  std::optional<std::string> next() {
+    if (!_source) {
+      return std::nullopt;
+    }
+    std::optional<std::string> chunk = _source();
+    if (!chunk) {
+      _source = nullptr;
+    }
+    return chunk;
+  }
+
+  /// an input iterator over the chunks
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string *;
+    using reference = const std::string &;
+
+    iterator() = default;
+    explicit iterator(DigitGenerator *g) : _generator{g} { ++*this; }
+
+    reference operator*() const { return _chunk; }
+    pointer operator->() const { return &_chunk; }
+    iterator &operator++() {
+      std::optional<std::string> chunk = _generator->next();
+      if (chunk) {
+        _chunk = std::move(*chunk);
+      } else {
+        _generator = nullptr;
+      }
+      return *this;
+    }
+    bool operator==(const iterator &rhs) const {
+      return _generator == rhs._generator;
+    }
+    bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+  private:
+    DigitGenerator *_generator = nullptr;
+    std::string _chunk;
+  };
+
+  iterator begin() { return iterator{this}; }
+  iterator end() { return iterator{}; } // NOLINT(readability-*)
+
+private:
+  Source _source;
+};
+
+namespace detail {
+
+/// append one limb's digits, zero-padded to BigInt::EXP unless it leads
+inline void append_limb(std::string &str, std::uint64_t limb,
+                        const bool leading) {
+  if (leading) {
+    str += std::to_string(limb);
+    return;
+  }
+  const std::size_t end = str.size() + static_cast<std::size_t>(BigInt::EXP);
+  str.resize(end, '0');
+  for (std::size_t i = end; limb > 0; limb /= 10) {
+    str[--i] = static_cast<char>('0' + limb % 10);
+  }
+}
+
+/// @return a generator of the first n digits of a constant at doubling n
+inline DigitGenerator
+progressive(std::function<std::string(std::size_t)> first_digits,
+            const std::size_t initial) {
+  std::size_t done = 0;
+  std::size_t n = std::max<std::size_t>(initial, 1);
+  return DigitGenerator{
+      [first_digits = std::move(first_digits), done,
+       n]() mutable -> std::optional<std::string> {
+        std::string digits = first_digits(n);
+        digits.erase(0, done);
+        done = n;
+        n *= 2;
+        return digits;
+      }};
+}
+
+} // namespace detail
+
+/**
+ * @brief The digits of an existing BigInt, a few limbs at a time, without
+ *        building the whole string.
+ * @param limbs_per_chunk Each chunk has this many limbs of BigInt::EXP digits.
+ */
+[[nodiscard]] inline DigitGenerator
+digits(BigInt x, const std::size_t limbs_per_chunk = 64) {
+  auto value = std::make_shared<const BigInt>(std::move(x));
+  std::size_t next = value->limbs().size(); // limbs above this are out
+  const std::size_t per = std::max<std::size_t>(limbs_per_chunk, 1);
+  return DigitGenerator{
+      [value, next, per]() mutable -> std::optional<std::string> {
+        if (next == 0) {
+          return std::nullopt;
+        }
+        const detail::Limbs &v = value->limbs();
+        std::string chunk;
+        if (next == v.size() && *value < 0) {
+          chunk += '-';
+        }
+        const std::size_t stop = next > per ? next - per : 0;
+        for (; next > stop; --next) {
+          detail::append_limb(chunk, v[next - 1], next == v.size());
+        }
+        return chunk;
+      }};
+}
+
+/**
+ * @brief The digits of a * b, leading digits first, while the product is
+ *        still being computed.
+ *
+ * b is split into `blocks` pieces, multiplied into a running sum from the
+ * most significant piece down. Once the pieces above k limbs are in, what
+ * remains adds less than BASE^(k + size of a), so every limb above that is
+ * final except for a carry rippling up through limbs of BASE - 1; a chunk
+ * goes out as soon as a limb stops the ripple. The first digits arrive after
+ * about 1 / blocks of the work; the unbalanced products cost more in total,
+ * about twice a * b with 4 blocks and more with more blocks.
+ */
+[[nodiscard]] inline DigitGenerator
+product_digits(BigInt a, BigInt b, const std::size_t blocks = 4) {
+  struct State {
+    detail::Limbs a;
+    detail::Limbs b;
+    detail::Limbs sum;     ///< the product of a and the pieces so far
+    std::size_t block;     ///< limbs per piece
+    std::size_t piece;     ///< pieces still to add
+    std::size_t next;      ///< limbs above this are out
+    bool negative;         ///< the sign is still to be written
+    bool leading = true;   ///< no nonzero limb written yet
+  };
+  auto s = std::make_shared<State>();
+  s->negative = !detail::is_zero(a.limbs()) && !detail::is_zero(b.limbs()) &&
+                (a < 0) != (b < 0);
+  s->a = a.limbs();
+  s->b = b.limbs();
+  s->sum.assign(s->a.size() + s->b.size(), 0);
+  const std::size_t pieces = std::clamp<std::size_t>(blocks, 1, s->b.size());
+  s->block = (s->b.size() + pieces - 1) / pieces;
+  s->piece = (s->b.size() + s->block - 1) / s->block;
+  s->next = s->sum.size();
+
+  return DigitGenerator{[s]() -> std::optional<std::string> {
+    std::string chunk;
+    if (s->negative) {
+      chunk += '-';
+      s->negative = false;
+    }
+    while (s->next > 0) {
+      std::size_t final_above = 0; // limbs at and above this are final
+      if (s->piece > 0) {
+        --s->piece;
+        const std::size_t lo = s->piece * s->block;
+        const std::size_t hi = std::min(lo + s->block, s->b.size());
+        detail::Limbs slice(s->b.begin() + static_cast<std::ptrdiff_t>(lo),
+                            s->b.begin() + static_cast<std::ptrdiff_t>(hi));
+        detail::trim(slice);
+        const detail::Limbs p = detail::mul(s->a, slice);
+        std::uint64_t *const r = s->sum.data() + lo;
+        const std::size_t n = s->sum.size() - lo;
+        detail::add_1(r + p.size(), n - p.size(),
+                      detail::add_n(r, r, p.data(), p.size()));
+
+        if (s->piece > 0) {
+          // a carry into limb lo + |a| ripples up to the first limb < BASE - 1
+          std::size_t stop = lo + s->a.size();
+          while (stop < s->next && s->sum[stop] == BigInt::BASE - 1) {
+            ++stop;
+          }
+          final_above = std::min(stop + 1, s->next);
+        }
+      }
+      for (; s->next > final_above; --s->next) {
+        const std::uint64_t limb = s->sum[s->next - 1];
+        if (s->leading && limb == 0 && s->next > 1) {
+          continue;
+        }
+        detail::append_limb(chunk, limb, s->leading);
+        s->leading = false;
+      }
+      if (!chunk.empty() && chunk != "-") {
+        return chunk;
+      }
+    }
+    return std::nullopt;
+  }};
+}
+
+/**
+ * @brief The digits of sqrt(n): its integer part as the first chunk, then the
+ *        fractional digits (without a point) at doubling precision, forever.
+ * @throws std::invalid_argument if `n` is negative.
+ */
+[[nodiscard]] inline DigitGenerator
+sqrt_digits(BigInt n, const std::size_t initial = 64) {
+  if (n < 0) {
+    throw std::invalid_argument("sch::sqrt_digits() : negative radicand");
+  }
+  auto root = std::make_shared<const BigInt>(isqrt(n));
+  bool whole = true;
+  DigitGenerator fraction = detail::progressive(
+      [n = std::move(n), root](const std::size_t k) {
+        // floor(sqrt(n) 10^k) - floor(sqrt(n)) 10^k, padded to k digits
+        const BigInt scale = pow(BigInt{10}, k);
+        std::string digits =
+            (isqrt(n * scale * scale) - *root * scale).to_string();
+        digits.insert(0, k - digits.size(), '0');
+        return digits;
+      },
+      initial);
+  return DigitGenerator{
+      [root, whole,
+       fraction = std::move(fraction)]() mutable -> std::optional<std::string> {
+        if (whole) {
+          whole = false;
+          return root->to_string();
+        }
+        return fraction.next();
+      }};
+}
+
+/// @brief The digits of pi ("31415..."), at doubling precision, forever.
+[[nodiscard]] inline DigitGenerator pi_digit_stream(
+    const std::size_t initial = 64) {
+  return detail::progressive([](const std::size_t n) { return pi_digits(n); },
+                             initial);
+}
+
+/// @brief The digits of e ("27182..."), at doubling precision, forever.
+[[nodiscard]] inline DigitGenerator e_digit_stream(
+    const std::size_t initial = 64) {
+  return detail::progressive([](const std::size_t n) { return e_digits(n); },
+                             initial);
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_DIGITS_HPP_
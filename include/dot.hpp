@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file dot.hpp
+ * @brief Sums of products with one carry pass at the end
+ *
+ * A DotAccumulator adds products into 128-bit columns without propagating
+ * carries: a short product's limb products land straight in their columns,
+ * a long one is formed by the usual kernels and its limbs added in. Carries
+ * are resolved only when a column could overflow, every few hundred limb
+ * products, and once at the end, instead of once per term.
+ */
+
+#ifndef SCH_INCLUDE_DOT_HPP_
+#define SCH_INCLUDE_DOT_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace sch {
+
+namespace detail {
+
+/**
+ * sum of a_i * b_i, kept as unnormalized columns, positive and negative
+ * terms apart
+ */
+class DotAccumulator {
+public:
+  /// add a * b, or subtract it if `negate`
+  void add(const BigInt &a, const BigInt &b, const bool negate = false) {
+    if (is_zero(a.limbs()) || is_zero(b.limbs())) {
+      return;
+    }
+    check_mul(a.limbs().size(), b.limbs().size());
+    const bool negative = (a.sign() != b.sign()) != negate;
+    Columns &c = negative ? _negative : _positive;
+    const Limbs &big =
+        a.limbs().size() >= b.limbs().size() ? a.limbs() : b.limbs();
+    const Limbs &small = &big == &a.limbs() ? b.limbs() : a.limbs();
+    const std::size_t n = big.size() + small.size();
+    if (c.sum.size() < n) {
+      c.sum.resize(n, 0);
+    }
+
+    if (small.size() < KARATSUBA_THRESHOLD) {
+      // a column gains at most |small| limb products
+      reserve(c, small.size());
+      for (std::size_t j = 0; j < small.size(); ++j) {
+        __uint128_t *const col = c.sum.data() + j;
+        const std::uint64_t v = small[j];
+        for (std::size_t i = 0; i < big.size(); ++i) {
+          col[i] += static_cast<__uint128_t>(big[i]) * v;
+        }
+      }
+    } else {
+      const Limbs p = mul(big, small);
+      reserve(c, 1);
+      for (std::size_t i = 0; i < p.size(); ++i) {
+        c.sum[i] += p[i];
+      }
+    }
+  }
+
+  /// @return the sum so far
+  [[nodiscard]] BigInt result() {
+    BigInt sum{to_limbs(_positive)};
+    sum -= BigInt{to_limbs(_negative)};
+    return sum;
+  }
+
+private:
+  /// columns stay below LIMIT (BASE - 1)^2 < 2^128
+  static constexpr std::size_t LIMIT = 320;
+
+  struct Columns {
+    std::vector<__uint128_t> sum;
+    std::size_t load = 0; ///< every column is below load (BASE - 1)^2
+  };
+
+  /// make room for `units` more limb products in every column
+  static void reserve(Columns &c, const std::size_t units) {
+    if (c.load + units > LIMIT) {
+      carry(c);
+    }
+    c.load += units;
+  }
+
+  /// resolve the carries, leaving every column below BASE
+  static void carry(Columns &c) {
+    __uint128_t carry = 0;
+    for (__uint128_t &col : c.sum) {
+      const __uint128_t t = col + carry;
+      col = t % LIMB_BASE;
+      carry = t / LIMB_BASE;
+    }
+    while (carry != 0) {
+      c.sum.push_back(carry % LIMB_BASE);
+      carry /= LIMB_BASE;
+    }
+    c.load = 1;
+  }
+
+  static Limbs to_limbs(Columns &c) {
+    carry(c);
+    Limbs v(c.sum.size());
+    std::transform(c.sum.begin(), c.sum.end(), v.begin(),
+                   [](const __uint128_t x) {
+                     return static_cast<std::uint64_t>(x);
+                   });
+    trim(v);
+    return v;
+  }
+
+  Columns _positive;
+  Columns _negative;
+};
+
+} // namespace detail
+
+/**
+ * @return sum of first1[i] * first2[i] over [first1, last1), with the
+ *         carries of all the products resolved once
+ */
+template <typename InputIt1, typename InputIt2>
+[[nodiscard]] BigInt dot(InputIt1 first1, const InputIt1 last1,
+                         InputIt2 first2) {
+  detail::DotAccumulator acc;
+  for (; first1 != last1; ++first1, ++first2) {
+    acc.add(*first1, *first2);
+  }
+  return acc.result();
+}
+
+/**
+ * @return sum of a[i] * b[i]
+ * @throws std::invalid_argument if the sizes differ.
+ */
+[[nodiscard]] inline BigInt dot(const std::vector<BigInt> &a,
+                                const std::vector<BigInt> &b) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("sch::dot() : size mismatch");
+  }
+  return dot(a.begin(), a.end(), b.begin());
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_DOT_HPP_
@@ -0,0 +1,653 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file limbs.hpp
+ * @brief Limb-level kernels on base 10^18 magnitudes
+ *
+ * These operate directly on the little endian limb vectors exposed by
+ * BigInt::limbs() and are shared by BigInt and the types built on top of it.
+ * None of them know about signs; a magnitude is "normalized" when it has no
+ * high zero limbs (zero is the single limb {0}).
+ */
+
+#ifndef SCH_INCLUDE_LIMBS_HPP_
+#define SCH_INCLUDE_LIMBS_HPP_
+
+#include "cancel.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sch::detail {
+
+/// limb storage; counted by stats() under SCH_ENABLE_STATS
+using Limbs = std::vector<std::uint64_t, LimbAllocator<std::uint64_t>>;
+
+inline constexpr std::uint64_t LIMB_BASE = 1'000'000'000'000'000'000; // 10^18
+
+// DIVISION BY THE BASE --------------------------------------------------------
+
+// BASE is divided with a precomputed reciprocal (Moller & Granlund, "Improved
+// division by invariant integers", 2011) instead of a 128-bit `/`, which is a
+// library call on every compiler we support.
+
+/// BASE shifted so that its most significant bit is set
+inline constexpr std::uint64_t NORM_BASE = LIMB_BASE << 4U;
+/// floor((2^128 - 1) / NORM_BASE) - 2^64
+inline constexpr std::uint64_t NORM_BASE_INV = static_cast<std::uint64_t>(
+    ~static_cast<__uint128_t>(0) / NORM_BASE);
+
+/**
+ * @param x the dividend; requires x < BASE * 2^64
+ * @param[out] rem x % BASE
+ * @return x / BASE
+ */
+inline std::uint64_t div_base(const __uint128_t x, std::uint64_t &rem) {
+  const __uint128_t u = x << 4U;
+  const auto u1 = static_cast<std::uint64_t>(u >> 64U);
+  const auto u0 = static_cast<std::uint64_t>(u);
+  __uint128_t q = static_cast<__uint128_t>(NORM_BASE_INV) * u1;
+  q += u;
+  auto q1 = static_cast<std::uint64_t>(q >> 64U) + 1;
+  const auto q0 = static_cast<std::uint64_t>(q);
+  std::uint64_t r = u0 - q1 * NORM_BASE;
+  if (r > q0) {
+    --q1;
+    r += NORM_BASE;
+  }
+  if (r >= NORM_BASE) {
+    ++q1;
+    r -= NORM_BASE;
+  }
+  rem = r >> 4U;
+  return q1;
+}
+
+/// @return (a * b) % BASE for a, b < BASE
+inline std::uint64_t mul_mod_base(const std::uint64_t a,
+                                  const std::uint64_t b) {
+  std::uint64_t rem = 0;
+  div_base(static_cast<__uint128_t>(a) * b, rem);
+  return rem;
+}
+
+// UTILITIES -------------------------------------------------------------------
+
+/// remove high zero limbs, leaving at least one limb
+inline void trim(Limbs &v) {
+  while (v.size() > 1 && v.back() == 0) {
+    v.pop_back();
+  }
+  if (v.empty()) {
+    v.push_back(0);
+  }
+}
+
+[[nodiscard]] inline bool is_zero(const Limbs &v) {
+  return v.empty() || (v.size() == 1 && v.front() == 0);
+}
+
+/// @return -1, 0, 1 as a <, ==, > b; both normalized
+[[nodiscard]] inline int compare(const Limbs &a, const Limbs &b) {
+  if (a.size() != b.size()) {
+    return a.size() < b.size() ? -1 : 1;
+  }
+  for (std::size_t i = a.size(); i-- > 0;) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+// ADDITION AND SUBTRACTION ----------------------------------------------------
+
+/**
+ * r[0..n) = a[0..n) + b[0..n)
+ * @return the carry out of the top limb (0 or 1)
+ */
+inline std::uint64_t add_n(std::uint64_t *r, const std::uint64_t *a,
+                           const std::uint64_t *b, const std::size_t n) {
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::uint64_t s = a[i] + b[i] + carry;
+    carry = s >= LIMB_BASE ? 1 : 0;
+    r[i] = s - carry * LIMB_BASE;
+  }
+  return carry;
+}
+
+/**
+ * r[0..n) = a[0..n) - b[0..n)
+ * @return the borrow out of the top limb (0 or 1)
+ */
+inline std::uint64_t sub_n(std::uint64_t *r, const std::uint64_t *a,
+                           const std::uint64_t *b, const std::size_t n) {
+  std::uint64_t borrow = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::uint64_t d = b[i] + borrow;
+    borrow = a[i] < d ? 1 : 0;
+    r[i] = a[i] + borrow * LIMB_BASE - d;
+  }
+  return borrow;
+}
+
+/// add `carry` into r[0..n), @return the carry out of the top limb
+inline std::uint64_t add_1(std::uint64_t *r, const std::size_t n,
+                           std::uint64_t carry) {
+  for (std::size_t i = 0; i < n && carry != 0; ++i) {
+    const std::uint64_t s = r[i] + carry;
+    carry = s / LIMB_BASE;
+    r[i] = s % LIMB_BASE;
+  }
+  return carry;
+}
+
+/// subtract `borrow` from r[0..n), @return the borrow out of the top limb
+inline std::uint64_t sub_1(std::uint64_t *r, const std::size_t n,
+                           std::uint64_t borrow) {
+  for (std::size_t i = 0; i < n && borrow != 0; ++i) {
+    if (r[i] >= borrow) {
+      r[i] -= borrow;
+      borrow = 0;
+    } else {
+      r[i] = r[i] + LIMB_BASE - borrow;
+      borrow = 1;
+    }
+  }
+  return borrow;
+}
+
+/// @return a + b
+[[nodiscard]] inline Limbs add(const Limbs &a, const Limbs &b) {
+  const Limbs &big = a.size() >= b.size() ? a : b;
+  const Limbs &small = a.size() >= b.size() ? b : a;
+  Limbs r(big.size() + 1, 0);
+  std::uint64_t carry =
+      add_n(r.data(), big.data(), small.data(), small.size());
+  for (std::size_t i = small.size(); i < big.size(); ++i) {
+    const std::uint64_t s = big[i] + carry;
+    carry = s >= LIMB_BASE ? 1 : 0;
+    r[i] = s - carry * LIMB_BASE;
+  }
+  r.back() = carry;
+  trim(r);
+  return r;
+}
+
+/// @return a - b; requires a >= b
+[[nodiscard]] inline Limbs sub(const Limbs &a, const Limbs &b) {
+  Limbs r(a.size(), 0);
+  std::uint64_t borrow = sub_n(r.data(), a.data(), b.data(), b.size());
+  for (std::size_t i = b.size(); i < a.size(); ++i) {
+    const std::uint64_t d = borrow;
+    borrow = a[i] < d ? 1 : 0;
+    r[i] = a[i] + borrow * LIMB_BASE - d;
+  }
+  trim(r);
+  return r;
+}
+
+// MULTIPLICATION --------------------------------------------------------------
+
+/**
+ * r[0..n) += a[0..n) * u
+ * @return the carry out of the top limb (< BASE)
+ */
+inline std::uint64_t addmul_1(std::uint64_t *r, const std::uint64_t *a,
+                              const std::size_t n, const std::uint64_t u) {
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    // (BASE-1)^2 + 2(BASE-1) < BASE^2, so the quotient fits a limb
+    const __uint128_t p = static_cast<__uint128_t>(a[i]) * u + r[i] + carry;
+    carry = div_base(p, r[i]);
+  }
+  return carry;
+}
+
+/**
+ * r[0..n) -= a[0..n) * u
+ * @return the borrow out of the top limb (< BASE)
+ */
+inline std::uint64_t submul_1(std::uint64_t *r, const std::uint64_t *a,
+                              const std::size_t n, const std::uint64_t u) {
+  std::uint64_t borrow = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t lo = 0;
+    std::uint64_t hi =
+        div_base(static_cast<__uint128_t>(a[i]) * u + borrow, lo);
+    if (r[i] < lo) {
+      r[i] += LIMB_BASE;
+      ++hi;
+    }
+    r[i] -= lo;
+    borrow = hi;
+  }
+  return borrow;
+}
+
+/**
+ * r[0..n) = a[0..n) * u
+ * @return the carry out of the top limb (< BASE)
+ */
+inline std::uint64_t mul_1(std::uint64_t *r, const std::uint64_t *a,
+                           const std::size_t n, const std::uint64_t u) {
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const __uint128_t p = static_cast<__uint128_t>(a[i]) * u + carry;
+    carry = div_base(p, r[i]);
+  }
+  return carry;
+}
+
+/**
+ * School-book multiplication, r[0..an+bn) = a[0..an) * b[0..bn)
+ * @note r must not alias a or b
+ */
+inline void mul_n(std::uint64_t *r, const std::uint64_t *a,
+                  const std::size_t an, const std::uint64_t *b,
+                  const std::size_t bn) {
+  std::fill(r, r + an + bn, 0);
+  for (std::size_t j = 0; j < bn; ++j) {
+    r[an + j] = addmul_1(r + j, a, an, b[j]);
+  }
+}
+
+/// below this many limbs in the shorter operand, school-book is faster
+inline constexpr std::size_t KARATSUBA_THRESHOLD = 32;
+
+/**
+ * Karatsuba multiplication, r[0..an+bn) = a[0..an) * b[0..bn)
+ * @note requires an >= bn; r must not alias a or b
+ */
+inline void mul_karatsuba(std::uint64_t *r, // NOLINT recursion
+                          const std::uint64_t *a, const std::size_t an,
+                          const std::uint64_t *b, const std::size_t bn) {
+  if (bn < KARATSUBA_THRESHOLD) {
+    checkpoint(static_cast<std::uint64_t>(an) * bn);
+    mul_n(r, a, an, b, bn);
+    return;
+  }
+
+  const std::size_t h = (an + 1) / 2;
+  if (bn <= h) {
+    // unbalanced: multiply b by bn-limb slices of a
+    std::fill(r, r + an + bn, 0);
+    Limbs t(2 * bn);
+    for (std::size_t i = 0; i < an; i += bn) {
+      const std::size_t n = std::min(bn, an - i);
+      if (n == bn) {
+        mul_karatsuba(t.data(), a + i, n, b, bn);
+      } else {
+        mul_karatsuba(t.data(), b, bn, a + i, n);
+      }
+      const std::uint64_t carry = add_n(r + i, r + i, t.data(), n + bn);
+      add_1(r + i + n + bn, an - i - n, carry);
+    }
+    return;
+  }
+
+  // a = a1 BASE^h + a0, b = b1 BASE^h + b0
+  const std::size_t an1 = an - h;
+  const std::size_t bn1 = bn - h;
+  Limbs sa(h + 1, 0); // a0 + a1
+  Limbs sb(h + 1, 0); // b0 + b1
+  std::copy(a + an1, a + h, sa.begin() + static_cast<std::ptrdiff_t>(an1));
+  sa[h] = add_1(sa.data() + an1, h - an1, add_n(sa.data(), a, a + h, an1));
+  std::copy(b + bn1, b + h, sb.begin() + static_cast<std::ptrdiff_t>(bn1));
+  sb[h] = add_1(sb.data() + bn1, h - bn1, add_n(sb.data(), b, b + h, bn1));
+
+  mul_karatsuba(r, a, h, b, h);                   // z0 = a0 b0
+  mul_karatsuba(r + 2 * h, a + h, an1, b + h, bn1); // z2 = a1 b1
+  Limbs z1(2 * h + 2);
+  mul_karatsuba(z1.data(), sa.data(), h + 1, sb.data(), h + 1);
+
+  // z1 = (a0 + a1)(b0 + b1) - z0 - z2 = a0 b1 + a1 b0
+  sub_1(z1.data() + 2 * h, 2, sub_n(z1.data(), z1.data(), r, 2 * h));
+  const std::size_t n2 = an1 + bn1;
+  sub_1(z1.data() + n2, z1.size() - n2,
+        sub_n(z1.data(), z1.data(), r + 2 * h, n2));
+
+  // r += z1 BASE^h; z1's high limbs past the product are zero
+  const std::size_t n1 = std::min(z1.size(), an + bn - h);
+  const std::uint64_t carry = add_n(r + h, r + h, z1.data(), n1);
+  add_1(r + h + n1, an + bn - h - n1, carry);
+}
+
+/**
+ * School-book squaring, r[0..2n) = a[0..n)^2; each cross product a_i a_j is
+ * formed once and doubled
+ * @note r must not alias a
+ */
+inline void sqr_n(std::uint64_t *r, const std::uint64_t *a,
+                  const std::size_t n) {
+  std::fill(r, r + 2 * n, 0);
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+    r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+  }
+  add_n(r, r, r, 2 * n); // double the cross products; no carry out
+
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t lo = 0;
+    const std::uint64_t hi =
+        div_base(static_cast<__uint128_t>(a[i]) * a[i], lo);
+    const std::uint64_t s0 = r[2 * i] + lo + carry;
+    const std::uint64_t c0 = s0 / LIMB_BASE;
+    r[2 * i] = s0 % LIMB_BASE;
+    const std::uint64_t s1 = r[2 * i + 1] + hi + c0;
+    carry = s1 / LIMB_BASE;
+    r[2 * i + 1] = s1 % LIMB_BASE;
+  }
+}
+
+/**
+ * Karatsuba squaring, r[0..2n) = a[0..n)^2, with three half-size squares
+ * @note r must not alias a
+ */
+inline void sqr_karatsuba(std::uint64_t *r, // NOLINT recursion
+                          const std::uint64_t *a, const std::size_t n) {
+  if (n < KARATSUBA_THRESHOLD) {
+    checkpoint(static_cast<std::uint64_t>(n) * (n + 1) / 2);
+    sqr_n(r, a, n);
+    return;
+  }
+
+  // a = a1 BASE^h + a0
+  const std::size_t h = (n + 1) / 2;
+  const std::size_t n1 = n - h;
+  Limbs sa(h + 1, 0); // a0 + a1
+  std::copy(a + n1, a + h, sa.begin() + static_cast<std::ptrdiff_t>(n1));
+  sa[h] = add_1(sa.data() + n1, h - n1, add_n(sa.data(), a, a + h, n1));
+
+  sqr_karatsuba(r, a, h);              // z0 = a0^2
+  sqr_karatsuba(r + 2 * h, a + h, n1); // z2 = a1^2
+  Limbs z1(2 * h + 2);
+  sqr_karatsuba(z1.data(), sa.data(), h + 1);
+
+  // z1 = (a0 + a1)^2 - z0 - z2 = 2 a0 a1
+  sub_1(z1.data() + 2 * h, 2, sub_n(z1.data(), z1.data(), r, 2 * h));
+  sub_1(z1.data() + 2 * n1, z1.size() - 2 * n1,
+        sub_n(z1.data(), z1.data(), r + 2 * h, 2 * n1));
+
+  const std::size_t m = std::min(z1.size(), 2 * n - h);
+  const std::uint64_t carry = add_n(r + h, r + h, z1.data(), m);
+  add_1(r + h + m, 2 * n - h - m, carry);
+}
+
+/// @return a^2
+[[nodiscard]] inline Limbs sqr(const Limbs &a) {
+  const TraceScope trace{a.size() < KARATSUBA_THRESHOLD ? Algo::sqr_schoolbook
+                                                        : Algo::sqr_karatsuba,
+                         a.size(), a.size()};
+  Limbs r(2 * a.size(), 0);
+  sqr_karatsuba(r.data(), a.data(), a.size());
+  trim(r);
+  return r;
+}
+
+/// @return a * b
+[[nodiscard]] inline Limbs mul(const Limbs &a, const Limbs &b) {
+  const Limbs &big = a.size() >= b.size() ? a : b;
+  const Limbs &small = a.size() >= b.size() ? b : a;
+  const TraceScope trace{small.size() < KARATSUBA_THRESHOLD
+                             ? Algo::mul_schoolbook
+                             : Algo::mul_karatsuba,
+                         big.size(), small.size()};
+  Limbs r(a.size() + b.size(), 0);
+  mul_karatsuba(r.data(), big.data(), big.size(), small.data(), small.size());
+  trim(r);
+  return r;
+}
+
+// DIVISION --------------------------------------------------------------------
+
+/**
+ * q[0..n) = a[0..n) / d
+ * @return a[0..n) % d
+ * @note q may alias a
+ */
+inline std::uint64_t divmod_1(std::uint64_t *q, const std::uint64_t *a,
+                              const std::size_t n, const std::uint64_t d) {
+  std::uint64_t rem = 0;
+  for (std::size_t i = n; i-- > 0;) {
+    const __uint128_t cur = static_cast<__uint128_t>(rem) * LIMB_BASE + a[i];
+    q[i] = static_cast<std::uint64_t>(cur / d);
+    rem = static_cast<std::uint64_t>(cur % d);
+  }
+  return rem;
+}
+
+/// @return d^{-1} mod BASE, for d coprime to 10
+[[nodiscard]] inline std::uint64_t inv_mod_base(const std::uint64_t d) {
+  // inverse mod 10 from a table, then Newton lifting to 10^32 >= BASE
+  constexpr std::uint64_t inv10[] = {0, 1, 0, 7, 0, 0, 0, 3, 0, 9};
+  std::uint64_t x = inv10[d % 10];
+  for (int i = 0; i < 5; ++i) {
+    const std::uint64_t dx = mul_mod_base(d % LIMB_BASE, x);
+    x = mul_mod_base(x, (2 + LIMB_BASE - dx) % LIMB_BASE);
+  }
+  return x;
+}
+
+// SHIFTS ----------------------------------------------------------------------
+
+/// @return floor(a / BASE^k)
+[[nodiscard]] inline Limbs shift_down(const Limbs &a, const std::size_t k) {
+  if (k >= a.size()) {
+    return Limbs{0};
+  }
+  return Limbs(a.begin() + static_cast<std::ptrdiff_t>(k), a.end());
+}
+
+/// @return a % BASE^k
+[[nodiscard]] inline Limbs truncate(const Limbs &a, const std::size_t k) {
+  Limbs r(a.begin(),
+          a.begin() + static_cast<std::ptrdiff_t>(std::min(k, a.size())));
+  trim(r);
+  return r;
+}
+
+/// @return a * BASE^k
+[[nodiscard]] inline Limbs shift_up(const Limbs &a, const std::size_t k) {
+  if (is_zero(a)) {
+    return Limbs{0};
+  }
+  Limbs r(k, 0);
+  r.insert(r.end(), a.begin(), a.end());
+  return r;
+}
+
+/// @return 10^e for e < EXP
+[[nodiscard]] constexpr std::uint64_t pow10(const std::size_t e) {
+  std::uint64_t p = 1;
+  for (std::size_t i = 0; i < e; ++i) {
+    p *= 10;
+  }
+  return p;
+}
+
+// LONG DIVISION ---------------------------------------------------------------
+
+/**
+ * Knuth's algorithm D, q = a / b and r = a % b
+ * @note requires b.size() >= 2, b normalized
+ */
+inline void divmod_knuth(const Limbs &a, const Limbs &b, Limbs &q, Limbs &r) {
+  const std::size_t n = b.size();
+  if (a.size() < n) {
+    q = Limbs{0};
+    r = a;
+    trim(r);
+    return;
+  }
+  const std::size_t m = a.size() - n;
+
+  // scale so that the top limb of the divisor is at least BASE / 2
+  const std::uint64_t scale = LIMB_BASE / (b.back() + 1);
+  Limbs u(a.size() + 1, 0);
+  Limbs v(n, 0);
+  u.back() = mul_1(u.data(), a.data(), a.size(), scale);
+  mul_1(v.data(), b.data(), n, scale);
+
+  q.assign(m + 1, 0);
+  const std::uint64_t v1 = v[n - 1];
+  const std::uint64_t v2 = v[n - 2];
+  for (std::size_t j = m + 1; j-- > 0;) {
+    checkpoint(n);
+    const __uint128_t top =
+        static_cast<__uint128_t>(u[j + n]) * LIMB_BASE + u[j + n - 1];
+    __uint128_t qhat = top / v1;
+    __uint128_t rhat = top % v1;
+    while (qhat >= LIMB_BASE ||
+           qhat * v2 > rhat * LIMB_BASE + u[j + n - 2]) {
+      --qhat;
+      rhat += v1;
+      if (rhat >= LIMB_BASE) {
+        break;
+      }
+    }
+
+    auto qj = static_cast<std::uint64_t>(qhat);
+    const std::uint64_t borrow = submul_1(&u[j], v.data(), n, qj);
+    if (u[j + n] < borrow) { // qhat was one too large: add back
+      --qj;
+      const std::uint64_t carry = add_n(&u[j], &u[j], v.data(), n);
+      u[j + n] = u[j + n] + carry - borrow;
+    } else {
+      u[j + n] -= borrow;
+    }
+    q[j] = qj;
+  }
+
+  u.resize(n);
+  divmod_1(u.data(), u.data(), n, scale);
+  r = std::move(u);
+  trim(q);
+  trim(r);
+}
+
+/**
+ * divisors of at least this many limbs divide through a Newton reciprocal,
+ * whose recursion bottoms out in divmod_knuth() below half of it. Set from
+ * a 2k by k limb divmod at -O2, Newton against Knuth: 15.8 vs 14.3 ms at
+ * k = 1000, 27 vs 34 ms at 1500, 51 vs 58 ms at 2000, 143 vs 229 ms at 4000.
+ */
+inline constexpr std::size_t DIV_NEWTON_THRESHOLD = 1500;
+
+/// @return a - b, or b - a with `negative` set; both normalized
+[[nodiscard]] inline Limbs signed_sub(const Limbs &a, const Limbs &b,
+                                      bool &negative) {
+  negative = compare(a, b) < 0;
+  return negative ? sub(b, a) : sub(a, b);
+}
+
+/**
+ * @return floor(BASE^(2k) / d) for a normalized d of k limbs
+ *
+ * Newton's iteration x' = x + x (BASE^(2k) - d x) / BASE^(2k), started from
+ * the reciprocal of d's top half and finished with a remainder correction.
+ */
+[[nodiscard]] inline Limbs reciprocal(const Limbs &d) { // NOLINT recursion
+  const std::size_t k = d.size();
+  const TraceScope trace{Algo::reciprocal, 2 * k + 1, k};
+  Limbs power(2 * k + 1, 0); // BASE^(2k)
+  power.back() = 1;
+  if (k < DIV_NEWTON_THRESHOLD / 2) {
+    Limbs x;
+    Limbs r;
+    if (k == 1) {
+      x.resize(power.size());
+      divmod_1(x.data(), power.data(), power.size(), d.front());
+      trim(x);
+    } else {
+      divmod_knuth(power, d, x, r);
+    }
+    return x;
+  }
+
+  // the top h limbs give a little more than half the precision needed
+  const std::size_t h = k / 2 + 2;
+  const Limbs x0 = shift_up(reciprocal(shift_down(d, k - h)), k - h);
+
+  bool negative = false;
+  const Limbs e = signed_sub(power, mul(d, x0), negative);
+  const Limbs step = shift_down(mul(x0, e), 2 * k);
+  Limbs x = negative ? sub(x0, add(step, Limbs{1})) : add(x0, step);
+
+  // now x is within a few units of the answer: fix it with r = BASE^2k - d x
+  Limbs r = signed_sub(power, mul(d, x), negative);
+  while (negative) {
+    x = sub(x, Limbs{1});
+    r = signed_sub(d, r, negative);
+  }
+  while (compare(r, d) >= 0) {
+    x = add(x, Limbs{1});
+    r = sub(r, d);
+  }
+  return x;
+}
+
+/**
+ * q = a / b and r = a % b, with school-book division for short divisors and
+ * Newton reciprocals for long ones
+ * @note requires b != 0; a and b normalized
+ */
+inline void divmod(const Limbs &a, const Limbs &b, Limbs &q, Limbs &r) {
+  if (compare(a, b) < 0) {
+    q = Limbs{0};
+    r = a;
+    return;
+  }
+  if (b.size() == 1) {
+    const TraceScope trace{Algo::div_1, a.size(), 1};
+    q.resize(a.size());
+    r = Limbs{divmod_1(q.data(), a.data(), a.size(), b.front())};
+    trim(q);
+    return;
+  }
+  if (b.size() < DIV_NEWTON_THRESHOLD) {
+    const TraceScope trace{Algo::div_knuth, a.size(), b.size()};
+    divmod_knuth(a, b, q, r);
+    return;
+  }
+  const TraceScope trace{Algo::div_newton, a.size(), b.size()};
+
+  // divide k limbs at a time: each chunk c < b BASE^k is at most 2k limbs, so
+  // floor(c R / BASE^(2k)) is short of c / b by at most 2
+  const std::size_t k = b.size();
+  const Limbs recip = reciprocal(b);
+  const std::size_t chunks = (a.size() + k - 1) / k;
+  q.assign(chunks * k, 0);
+  r = Limbs{0};
+  for (std::size_t c = chunks; c-- > 0;) {
+    const std::size_t lo = c * k;
+    const std::size_t hi = std::min(lo + k, a.size());
+    Limbs cur = shift_up(r, k);
+    cur.resize(std::max(cur.size(), k), 0);
+    std::copy(a.begin() + static_cast<std::ptrdiff_t>(lo),
+              a.begin() + static_cast<std::ptrdiff_t>(hi), cur.begin());
+    trim(cur);
+
+    Limbs qc = shift_down(mul(cur, recip), 2 * k);
+    r = sub(cur, mul(qc, b));
+    while (compare(r, b) >= 0) {
+      r = sub(r, b);
+      qc = add(qc, Limbs{1});
+    }
+    std::copy(qc.begin(), qc.end(),
+              q.begin() + static_cast<std::ptrdiff_t>(lo));
+  }
+  trim(q);
+}
+
+} // namespace sch::detail
+
+#endif // SCH_INCLUDE_LIMBS_HPP_
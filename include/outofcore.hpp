@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file outofcore.hpp
+ * @brief Multiplication of operands larger than memory, through
+ *        memory-mapped files
+ *
+ * Operands, product and scratch live in LimbFiles: files of raw little endian
+ * base 10^18 limbs, mapped into memory. mul_out_of_core() runs the top levels
+ * of Karatsuba's recursion on the files themselves, where every step (the
+ * sums of halves, the subtraction of z0 and z2, the final accumulation) is
+ * one sequential pass, and hands each subproduct that fits the memory budget
+ * to the in-memory kernel after reading it in one pass. Scratch files are
+ * unlinked as soon as they are created, so they vanish with the process.
+ *
+ * POSIX only (open, mmap); elsewhere the functions throw std::runtime_error.
+ */
+
+#ifndef SCH_INCLUDE_OUTOFCORE_HPP_
+#define SCH_INCLUDE_OUTOFCORE_HPP_
+
+#include "BigInt.hpp"
+#include "limbs.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SCH_HAVE_MMAP 1
+#endif
+
+namespace sch {
+
+/**
+ * @class LimbFile
+ * @brief A magnitude stored as raw little endian limbs in a memory-mapped
+ *        file. Move-only; unmapped and closed on destruction.
+ */
+class LimbFile {
+public:
+  LimbFile() = default;
+  ~LimbFile() { release(); }
+  LimbFile(LimbFile &&other) noexcept { *this = std::move(other); }
+  LimbFile &operator=(LimbFile &&other) noexcept {
+    if (this != &other) {
+      release();
+      _fd = std::exchange(other._fd, -1);
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+    }
+    return *this;
+  }
+  LimbFile(const LimbFile &) = delete;
+  LimbFile &operator=(const LimbFile &) = delete;
+
+  /// @return a new file of `limbs` zero limbs at `path`, replacing any
+  [[nodiscard]] static LimbFile create(const std::string &path,
+                                       const std::size_t limbs) {
+#ifdef SCH_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      fail("sch::LimbFile::create() : open " + path);
+    }
+    return LimbFile{fd, limbs, true};
+#else
+    static_cast<void>(path);
+    static_cast<void>(limbs);
+    unsupported();
+#endif
+  }
+
+  /// @return the existing file at `path`
+  [[nodiscard]] static LimbFile open(const std::string &path,
+                                     const bool writable = false) {
+#ifdef SCH_HAVE_MMAP
+    const int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+      fail("sch::LimbFile::open() : open " + path);
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error{error, std::generic_category(),
+                              "sch::LimbFile::open() : stat " + path};
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes % sizeof(std::uint64_t) != 0) {
+      ::close(fd);
+      throw std::invalid_argument("sch::LimbFile::open() : " + path +
+                                  " is not a whole number of limbs");
+    }
+    return LimbFile{fd, bytes / sizeof(std::uint64_t), writable};
+#else
+    static_cast<void>(path);
+    static_cast<void>(writable);
+    unsupported();
+#endif
+  }
+
+  /// @return a scratch file of `limbs` zero limbs in `directory`, deleted
+  ///         when it is closed
+  [[nodiscard]] static LimbFile temporary(const std::string &directory,
+                                          const std::size_t limbs) {
+#ifdef SCH_HAVE_MMAP
+    std::string name = (std::filesystem::path{directory} / "sch-XXXXXX");
+    const int fd = ::mkstemp(name.data());
+    if (fd < 0) {
+      fail("sch::LimbFile::temporary() : mkstemp in " + directory);
+    }
+    ::unlink(name.c_str());
+    return LimbFile{fd, limbs, true};
+#else
+    static_cast<void>(directory);
+    static_cast<void>(limbs);
+    unsupported();
+#endif
+  }
+
+  /// @return |x| written to a new file at `path`
+  [[nodiscard]] static LimbFile write(const std::string &path,
+                                      const BigInt &x) {
+    LimbFile file = create(path, x.limbs().size());
+    std::copy(x.limbs().begin(), x.limbs().end(), file.data());
+    return file;
+  }
+
+  /// @return the magnitude, read into memory
+  [[nodiscard]] BigInt to_bigint() const {
+    detail::Limbs v(_data, _data + _size);
+    if (v.empty()) {
+      v.push_back(0);
+    }
+    detail::trim(v);
+    return BigInt{std::move(v)};
+  }
+
+  [[nodiscard]] std::size_t size() const { return _size; }
+  [[nodiscard]] std::uint64_t *data() { return _data; }
+  [[nodiscard]] const std::uint64_t *data() const { return _data; }
+
+  /// @return the size without high zero limbs (at least 1)
+  [[nodiscard]] std::size_t significant() const {
+    std::size_t n = _size;
+    while (n > 1 && _data[n - 1] == 0) {
+      --n;
+    }
+    return std::max<std::size_t>(n, 1);
+  }
+
+private:
+#ifdef SCH_HAVE_MMAP
+  /// maps fd, sized to `limbs` limbs when writable
+  LimbFile(const int fd, const std::size_t limbs, const bool writable)
+      : _fd{fd} {
+    const std::size_t bytes = limbs * sizeof(*_data);
+    if (writable && ::lseek(fd, 0, SEEK_END) < static_cast<off_t>(bytes) &&
+        ::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+      fail_closing("sch::LimbFile : ftruncate");
+    }
+    if (limbs == 0) {
+      return;
+    }
+    void *const p =
+        ::mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+               MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      fail_closing("sch::LimbFile : mmap");
+    }
+    _size = limbs;
+    ::madvise(p, bytes, MADV_SEQUENTIAL);
+    _data = static_cast<std::uint64_t *>(p);
+  }
+#endif
+
+  void release() noexcept {
+#ifdef SCH_HAVE_MMAP
+    if (_data != nullptr) {
+      ::munmap(_data, _size * sizeof(*_data));
+    }
+    if (_fd >= 0) {
+      ::close(_fd);
+    }
+#endif
+    _fd = -1;
+    _data = nullptr;
+    _size = 0;
+  }
+
+  [[noreturn]] static void fail(const std::string &what) {
+    throw std::system_error{errno, std::generic_category(), what};
+  }
+  [[noreturn]] void fail_closing(const std::string &what) {
+    const int error = errno;
+    release();
+    throw std::system_error{error, std::generic_category(), what};
+  }
+  [[noreturn]] static void unsupported() {
+    throw std::runtime_error(
+        "sch::LimbFile : memory-mapped files need a POSIX platform");
+  }
+
+  int _fd = -1;
+  std::uint64_t *_data = nullptr;
+  std::size_t _size = 0;
+};
+
+/// where and in how much memory mul_out_of_core() works
+struct OutOfCoreOptions {
+  /// the directory of the scratch files
+  std::string directory = std::filesystem::temp_directory_path().string();
+  /// subproducts whose operands total at most this many limbs (8 bytes each,
+  /// at least 64) are computed in memory, which takes about 4 times as many
+  std::size_t memory_limbs = std::size_t{1} << 24;
+};
+
+namespace detail {
+
+/**
+ * r[0..an+bn) = a[0..an) * b[0..bn), out of core above the memory budget
+ * @note requires an >= bn >= 1; r must not alias a or b
+ */
+inline void mul_out_of_core(std::uint64_t *r, // NOLINT recursion
+                            const std::uint64_t *a, const std::size_t an,
+                            const std::uint64_t *b, const std::size_t bn,
+                            const OutOfCoreOptions &options) {
+  // below 2 KARATSUBA_THRESHOLD the halves of a split would not shrink
+  const std::size_t budget =
+      std::max(options.memory_limbs, 2 * KARATSUBA_THRESHOLD);
+  if (an + bn <= budget) {
+    // one sequential read of each operand, one write of the product
+    const Limbs la(a, a + an);
+    const Limbs lb(b, b + bn);
+    Limbs p(an + bn);
+    mul_karatsuba(p.data(), la.data(), an, lb.data(), bn);
+    std::copy(p.begin(), p.end(), r);
+    return;
+  }
+
+  const std::size_t h = (an + 1) / 2;
+  if (bn <= h) {
+    // unbalanced: multiply b by slices of a of at least bn limbs, as large
+    // as the budget allows, and accumulate
+    const std::size_t slice = std::max(bn, budget / 2);
+    std::fill(r, r + an + bn, 0);
+    LimbFile t = LimbFile::temporary(options.directory, slice + bn);
+    for (std::size_t i = 0; i < an; i += slice) {
+      const std::size_t n = std::min(slice, an - i);
+      if (n >= bn) {
+        mul_out_of_core(t.data(), a + i, n, b, bn, options);
+      } else {
+        mul_out_of_core(t.data(), b, bn, a + i, n, options);
+      }
+      const std::uint64_t carry = add_n(r + i, r + i, t.data(), n + bn);
+      add_1(r + i + n + bn, an - i - n, carry);
+    }
+    return;
+  }
+
+  // Karatsuba, as in mul_karatsuba(), with the halves' sums and z1 on disk
+  const std::size_t an1 = an - h;
+  const std::size_t bn1 = bn - h;
+  {
+    LimbFile sa = LimbFile::temporary(options.directory, h + 1); // a0 + a1
+    LimbFile sb = LimbFile::temporary(options.directory, h + 1); // b0 + b1
+    std::uint64_t *const pa = sa.data();
+    std::uint64_t *const pb = sb.data();
+    std::copy(a + an1, a + h, pa + an1);
+    pa[h] = add_1(pa + an1, h - an1, add_n(pa, a, a + h, an1));
+    std::copy(b + bn1, b + h, pb + bn1);
+    pb[h] = add_1(pb + bn1, h - bn1, add_n(pb, b, b + h, bn1));
+
+    LimbFile z1 = LimbFile::temporary(options.directory, 2 * h + 2);
+    mul_out_of_core(z1.data(), pa, h + 1, pb, h + 1, options);
+    sa = LimbFile{}; // the sums are done with: release their pages
+    sb = LimbFile{};
+
+    mul_out_of_core(r, a, h, b, h, options);                   // z0
+    mul_out_of_core(r + 2 * h, a + h, an1, b + h, bn1, options); // z2
+
+    // z1 -= z0 + z2, then r += z1 BASE^h
+    std::uint64_t *const p1 = z1.data();
+    sub_1(p1 + 2 * h, 2, sub_n(p1, p1, r, 2 * h));
+    const std::size_t n2 = an1 + bn1;
+    sub_1(p1 + n2, z1.size() - n2, sub_n(p1, p1, r + 2 * h, n2));
+    const std::size_t n1 = std::min(z1.size(), an + bn - h);
+    const std::uint64_t carry = add_n(r + h, r + h, p1, n1);
+    add_1(r + h + n1, an + bn - h - n1, carry);
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief r = |a| * |b|, keeping operands, product and scratch in
+ *        memory-mapped files.
+ * @param r A writable file of at least a.size() + b.size() limbs; its limbs
+ *        past the product are zeroed.
+ * @throws std::invalid_argument if `r` is too small.
+ * @throws std::system_error if a scratch file cannot be created.
+ */
+inline void mul_out_of_core(const LimbFile &a, const LimbFile &b, LimbFile &r,
+                            const OutOfCoreOptions &options = {}) {
+  const std::size_t an = a.significant();
+  const std::size_t bn = b.significant();
+  if (r.size() < an + bn) {
+    throw std::invalid_argument(
+        "sch::mul_out_of_core() : product file too small");
+  }
+  const bool a_zero = a.size() == 0 || (an == 1 && a.data()[0] == 0);
+  const bool b_zero = b.size() == 0 || (bn == 1 && b.data()[0] == 0);
+  std::fill(r.data(), r.data() + r.size(), 0);
+  if (a_zero || b_zero) {
+    return;
+  }
+  if (an >= bn) {
+    detail::mul_out_of_core(r.data(), a.data(), an, b.data(), bn, options);
+  } else {
+    detail::mul_out_of_core(r.data(), b.data(), bn, a.data(), an, options);
+  }
+}
+
+/**
+ * @brief a * b with the scratch in memory-mapped files, for products whose
+ *        scratch, not operands, would exceed memory.
+ */
+[[nodiscard]] inline BigInt mul_out_of_core(const BigInt &a, const BigInt &b,
+                                            const OutOfCoreOptions &options =
+                                                {}) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  LimbFile fa = LimbFile::temporary(options.directory, a.limbs().size());
+  LimbFile fb = LimbFile::temporary(options.directory, b.limbs().size());
+  std::copy(a.limbs().begin(), a.limbs().end(), fa.data());
+  std::copy(b.limbs().begin(), b.limbs().end(), fb.data());
+  LimbFile fr = LimbFile::temporary(options.directory,
+                                    a.limbs().size() + b.limbs().size());
+  mul_out_of_core(fa, fb, fr, options);
+  BigInt product = fr.to_bigint();
+  return (a < 0) != (b < 0) ? -std::move(product) : product;
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_OUTOFCORE_HPP_
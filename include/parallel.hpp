@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file parallel.hpp
+ * @brief The thread pool shared by every parallel algorithm in sch, and the
+ *        knobs that control it
+ *
+ * All parallel work goes through one process-wide Executor: by default a
+ * work-stealing ThreadPool with one thread per core, resized with
+ * set_num_threads() or replaced by your own with set_executor(). Each
+ * parallel algorithm also takes an ExecutionPolicy that caps the threads the
+ * call may use, down to `sch::seq` for none. The cap holds for everything the
+ * call forks: a parallel call made from inside another shares the enclosing
+ * call's threads instead of adding its own.
+ *
+ * Fork-join is deadlock-free on any executor: a TaskGroup that waits runs its
+ * own tasks that no thread has started yet, so nested parallel calls and
+ * executors with few (or busy) threads only lose parallelism, never progress.
+ */
+
+#ifndef SCH_INCLUDE_PARALLEL_HPP_
+#define SCH_INCLUDE_PARALLEL_HPP_
+
+#include "cancel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sch {
+
+/**
+ * @brief Runs tasks; implement it to put sch's parallelism on your own
+ *        threads.
+ *
+ * submit() may run the task at any later time, on any thread, including
+ * inline before returning. Tasks submitted by sch never throw.
+ */
+class Executor {
+public:
+  virtual ~Executor() = default;
+  virtual void submit(std::function<void()> task) = 0;
+  /// @return how many tasks can usefully run at once, counting the caller
+  [[nodiscard]] virtual unsigned concurrency() const = 0;
+};
+
+/**
+ * @class ThreadPool
+ * @brief A work-stealing pool of threads - 1 workers; the thread that waits
+ *        on a TaskGroup is the last one.
+ *
+ * Each worker owns a deque: tasks submitted from a worker go to the back of
+ * its own deque and are taken from there (newest first, while their data is
+ * still in cache); an idle worker steals from the front of the others'
+ * (oldest first, usually the largest pieces of a divide-and-conquer).
+ * Tasks from other threads are dealt round-robin.
+ */
+class ThreadPool final : public Executor {
+public:
+  explicit ThreadPool(const unsigned threads) {
+    const unsigned workers = threads > 1 ? threads - 1 : 0;
+    for (unsigned i = 0; i < workers; ++i) {
+      _shared->queues.push_back(std::make_unique<Queue>());
+    }
+    _threads.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+      _threads.emplace_back([shared = _shared, i] { work(*shared, i); });
+    }
+  }
+
+  /**
+   * Finishes the queued tasks, then joins the workers. When the last owner
+   * lets go from inside a task, that worker is detached instead and exits on
+   * its own once the task returns.
+   */
+  ~ThreadPool() override {
+    {
+      const std::lock_guard lock{_shared->mutex};
+      _shared->stop = true;
+    }
+    _shared->wake.notify_all();
+    for (auto &thread : _threads) {
+      if (thread.get_id() == std::this_thread::get_id()) {
+        thread.detach();
+      } else {
+        thread.join();
+      }
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void submit(std::function<void()> task) override {
+    Shared &s = *_shared;
+    if (s.queues.empty()) {
+      task();
+      return;
+    }
+    const std::size_t i =
+        worker_shared == &s
+            ? worker_index
+            : s.next.fetch_add(1, std::memory_order_relaxed) % s.queues.size();
+    {
+      const std::lock_guard lock{s.queues[i]->mutex};
+      s.queues[i]->tasks.push_back(std::move(task));
+    }
+    {
+      const std::lock_guard lock{s.mutex};
+      s.pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.wake.notify_one();
+  }
+
+  [[nodiscard]] unsigned concurrency() const override {
+    return static_cast<unsigned>(_threads.size()) + 1;
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  /// what the workers use, kept alive by them as well as by the pool
+  struct Shared {
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> pending{0}; ///< queued, not yet taken
+    std::mutex mutex;                    ///< guards sleeping and stop
+    std::condition_variable wake;
+    bool stop = false;
+  };
+
+  /// the pool and index of the worker running on this thread, if any
+  static inline thread_local const Shared *worker_shared = nullptr;
+  static inline thread_local std::size_t worker_index = 0;
+
+  static bool take(Shared &s, const std::size_t i,
+                   std::function<void()> &task) {
+    { // own queue, newest first
+      Queue &own = *s.queues[i];
+      const std::lock_guard lock{own.mutex};
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (std::size_t k = 1; k < s.queues.size(); ++k) { // steal, oldest first
+      Queue &victim = *s.queues[(i + k) % s.queues.size()];
+      const std::lock_guard lock{victim.mutex};
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void work(Shared &s, const std::size_t i) {
+    worker_shared = &s;
+    worker_index = i;
+    std::function<void()> task;
+    for (;;) {
+      if (take(s, i, task)) {
+        s.pending.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock lock{s.mutex};
+      s.wake.wait(lock, [&s] {
+        return s.stop || s.pending.load(std::memory_order_relaxed) > 0;
+      });
+      if (s.stop && s.pending.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+  std::shared_ptr<Shared> _shared = std::make_shared<Shared>();
+  std::vector<std::thread> _threads;
+};
+
+namespace detail {
+
+inline std::mutex executor_mutex;
+inline std::shared_ptr<Executor> global_executor;
+
+[[nodiscard]] inline unsigned default_threads() {
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+} // namespace detail
+
+/// @return the executor sch runs parallel work on, created on first use
+[[nodiscard]] inline std::shared_ptr<Executor> executor() {
+  const std::lock_guard lock{detail::executor_mutex};
+  if (!detail::global_executor) {
+    detail::global_executor =
+        std::make_shared<ThreadPool>(detail::default_threads());
+  }
+  return detail::global_executor;
+}
+
+/**
+ * @brief Run sch's parallel work on `e` from now on; nullptr restores the
+ *        default pool. Calls in progress finish on the executor they started
+ *        on.
+ */
+inline void set_executor(std::shared_ptr<Executor> e) {
+  std::shared_ptr<Executor> previous;
+  {
+    const std::lock_guard lock{detail::executor_mutex};
+    previous = std::exchange(detail::global_executor, std::move(e));
+  }
+  // a pool is joined here, outside the lock its workers may want
+}
+
+/**
+ * @brief Replace the executor with a ThreadPool of `n` threads, counting the
+ *        calling thread; 0 means one per core, and 1 runs everything on the
+ *        calling thread.
+ */
+inline void set_num_threads(const unsigned n) {
+  set_executor(std::make_shared<ThreadPool>(n == 0 ? detail::default_threads()
+                                                   : n));
+}
+
+/// @return the concurrency of the current executor
+[[nodiscard]] inline unsigned num_threads() {
+  return executor()->concurrency();
+}
+
+/**
+ * @brief How many threads one call may use. The default, `sch::par`, uses
+ *        the whole executor; `sch::seq` runs on the calling thread only.
+ */
+class ExecutionPolicy {
+public:
+  constexpr ExecutionPolicy() = default;
+
+  /// @return a policy that uses at most n threads (0: no limit)
+  [[nodiscard]] static constexpr ExecutionPolicy threads(const unsigned n) {
+    ExecutionPolicy p;
+    p._max_threads = n;
+    return p;
+  }
+
+  [[nodiscard]] constexpr unsigned max_threads() const { return _max_threads; }
+
+  /// @return the threads this call may use on the current executor
+  [[nodiscard]] unsigned concurrency() const {
+    if (_max_threads == 1) {
+      return 1;
+    }
+    const unsigned available = num_threads();
+    return _max_threads == 0 ? available : std::min(_max_threads, available);
+  }
+
+private:
+  unsigned _max_threads = 0;
+};
+
+inline constexpr ExecutionPolicy par{};
+inline constexpr ExecutionPolicy seq = ExecutionPolicy::threads(1);
+
+namespace detail {
+
+/**
+ * The threads one parallel call may still add to the one that made it. A
+ * slot is taken for every task handed to the executor and given back when
+ * that thread runs out of work; a call made from inside another takes each
+ * slot from the enclosing call's too, so nesting never goes over the cap.
+ */
+class ThreadSlots {
+public:
+  ThreadSlots(const unsigned helpers, std::shared_ptr<ThreadSlots> parent)
+      : _free{helpers}, _parent{std::move(parent)} {}
+
+  [[nodiscard]] bool try_acquire() {
+    unsigned n = _free.load(std::memory_order_relaxed);
+    do {
+      if (n == 0) {
+        return false;
+      }
+    } while (!_free.compare_exchange_weak(n, n - 1, std::memory_order_acquire,
+                                          std::memory_order_relaxed));
+    if (_parent && !_parent->try_acquire()) {
+      _free.fetch_add(1, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
+  void release() {
+    if (_parent) {
+      _parent->release();
+    }
+    _free.fetch_add(1, std::memory_order_release);
+  }
+
+private:
+  std::atomic<unsigned> _free;
+  std::shared_ptr<ThreadSlots> _parent;
+};
+
+/// the slots of the parallel call this thread works for, if any
+inline thread_local std::shared_ptr<ThreadSlots> current_slots;
+
+/// @return the slots of a call with `policy` on `e`, within the current call
+[[nodiscard]] inline std::shared_ptr<ThreadSlots>
+make_slots(const ExecutionPolicy policy, const Executor &e) {
+  const unsigned available = policy.max_threads() == 1 ? 1 : e.concurrency();
+  const unsigned threads = policy.max_threads() == 0
+                               ? available
+                               : std::min(policy.max_threads(), available);
+  return std::make_shared<ThreadSlots>(threads > 1 ? threads - 1 : 0,
+                                       current_slots);
+}
+
+/// makes `slots` those of the calling thread for its lifetime
+class SlotScope {
+public:
+  explicit SlotScope(std::shared_ptr<ThreadSlots> slots)
+      : _saved{std::exchange(current_slots, std::move(slots))} {}
+  ~SlotScope() { current_slots = std::move(_saved); }
+  SlotScope(const SlotScope &) = delete;
+  SlotScope &operator=(const SlotScope &) = delete;
+
+private:
+  std::shared_ptr<ThreadSlots> _saved;
+};
+
+/**
+ * Caps the parallel calls the calling thread makes within its lifetime, and
+ * all they fork, at the threads of `policy`; for algorithms that recurse
+ * through parallel_invoke() or TaskGroup without passing a policy down.
+ */
+class ThreadCap {
+public:
+  explicit ThreadCap(const ExecutionPolicy policy)
+      : _scope{make_slots(policy, *executor())} {}
+
+private:
+  SlotScope _scope;
+};
+
+} // namespace detail
+
+/**
+ * @class TaskGroup
+ * @brief Fork-join over the executor: run() tasks, then wait() for all of
+ *        them; the first exception a task throws is rethrown by wait().
+ *
+ * The tasks work for the operation (see cancel.hpp) of the thread that
+ * run() them, so cancellation and progress follow the work onto the pool.
+ *
+ * At most policy.concurrency() threads work on a group's tasks, counting the
+ * one that waits: a task goes to the executor only while the group (and the
+ * call it is nested in) has a thread to spare, and each thread it starts
+ * takes the group's queued tasks until none are left. The rest are run by
+ * wait().
+ */
+class TaskGroup {
+public:
+  TaskGroup() : TaskGroup{executor()} {}
+  explicit TaskGroup(const ExecutionPolicy policy)
+      : TaskGroup{executor(), policy} {}
+  explicit TaskGroup(std::shared_ptr<Executor> e,
+                     const ExecutionPolicy policy = par)
+      : _executor{std::move(e)} {
+    _state->slots = detail::make_slots(policy, *_executor);
+  }
+  ~TaskGroup() {
+    try {
+      wait();
+    } catch (...) { // NOLINT(bugprone-empty-catch) wait() to rethrow instead
+    }
+  }
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  template <typename F> void run(F &&f) {
+    auto task = std::make_shared<Task>(std::forward<F>(f));
+    _tasks.push_back(task);
+    bool submit = false;
+    {
+      const std::lock_guard lock{_state->mutex};
+      ++_state->unfinished;
+      submit = _state->slots->try_acquire();
+      if (!submit) {
+        _state->queued.push_back(task);
+      }
+    }
+    if (submit) {
+      _executor->submit(
+          [task, state = _state, op = detail::current_operation] {
+            const detail::OperationScope scope{op};
+            help(task, *state);
+          });
+    }
+  }
+
+  /// f() on the calling thread, counted as one of the group's threads
+  template <typename F> void run_here(const F &f) {
+    const detail::SlotScope scope{_state->slots};
+    f();
+  }
+
+  /// run the tasks no thread has started, then wait for the rest
+  void wait() {
+    while (!_tasks.empty()) { // newest first, like a worker
+      execute(*_tasks.back(), *_state);
+      _tasks.pop_back();
+    }
+    std::unique_lock lock{_state->mutex};
+    _state->done.wait(lock, [this] { return _state->unfinished == 0; });
+    if (_state->error) {
+      std::rethrow_exception(std::exchange(_state->error, nullptr));
+    }
+  }
+
+private:
+  struct Task {
+    template <typename F> explicit Task(F &&f) : fn{std::forward<F>(f)} {}
+    std::function<void()> fn;
+    std::atomic<bool> claimed{false};
+  };
+
+  struct State {
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t unfinished = 0;
+    std::exception_ptr error;
+    std::shared_ptr<detail::ThreadSlots> slots;
+    std::deque<std::shared_ptr<Task>> queued; ///< run() without a slot
+  };
+
+  /// on a thread of the executor: run `task`, then the queued ones
+  static void help(std::shared_ptr<Task> task, State &state) {
+    while (task) {
+      execute(*task, state);
+      task = nullptr;
+      const std::lock_guard lock{state.mutex};
+      while (!task && !state.queued.empty()) {
+        task = std::move(state.queued.front());
+        state.queued.pop_front();
+        if (task->claimed.load(std::memory_order_relaxed)) {
+          task = nullptr;
+        }
+      }
+      if (!task) {
+        state.slots->release();
+      }
+    }
+  }
+
+  /// run the task unless another thread already has
+  static void execute(Task &task, State &state) {
+    if (task.claimed.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    std::exception_ptr error;
+    try {
+      const detail::SlotScope scope{state.slots};
+      task.fn();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    task.fn = nullptr;
+    const std::lock_guard lock{state.mutex};
+    if (error && !state.error) {
+      state.error = error;
+    }
+    if (--state.unfinished == 0) {
+      state.done.notify_all();
+    }
+  }
+
+  std::shared_ptr<Executor> _executor;
+  std::shared_ptr<State> _state = std::make_shared<State>();
+  std::vector<std::shared_ptr<Task>> _tasks;
+};
+
+/**
+ * @brief f(i) for every i in [first, last), split into chunks over the
+ *        threads the policy allows.
+ */
+template <typename F>
+void parallel_for(const std::size_t first, const std::size_t last, const F &f,
+                  const ExecutionPolicy policy = par) {
+  if (first >= last) {
+    return;
+  }
+  const std::size_t n = last - first;
+  const unsigned threads = policy.concurrency();
+  if (threads <= 1 || n == 1) {
+    for (std::size_t i = first; i < last; ++i) {
+      f(i);
+    }
+    return;
+  }
+
+  // a few chunks per thread, taken in turn, so that uneven ones even out
+  const std::size_t chunks = std::min<std::size_t>(n, 4 * threads);
+  std::atomic<std::size_t> next{0};
+  const auto drain = [&f, &next, first, n, chunks] {
+    for (std::size_t c = next++; c < chunks; c = next++) {
+      for (std::size_t i = first + n * c / chunks;
+           i < first + n * (c + 1) / chunks; ++i) {
+        f(i);
+      }
+    }
+  };
+  TaskGroup group{policy};
+  for (unsigned t = 1; t < threads; ++t) {
+    group.run(drain);
+  }
+  group.run_here(drain);
+  group.wait();
+}
+
+/// @brief a() and b(), concurrently if the policy allows
+template <typename A, typename B>
+void parallel_invoke(const A &a, const B &b,
+                     const ExecutionPolicy policy = par) {
+  if (policy.concurrency() <= 1) {
+    a();
+    b();
+    return;
+  }
+  TaskGroup group{policy};
+  group.run(b);
+  group.run_here(a);
+  group.wait();
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_PARALLEL_HPP_
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file probes.hpp
+ * @brief Optional USDT (SystemTap/DTrace) static probes
+ *
+ * Define SCH_ENABLE_USDT (or use the SCH_ENABLE_USDT CMake option) on a
+ * platform that provides <sys/sdt.h> to place probes of provider "sch" at the
+ * entry and return of the multiplication, division, modulo, pow and
+ * conversion routines. Each carries the operand sizes in limbs (for pow, the
+ * base size and the exponent; for conversions, the size in limbs and in
+ * characters), so that bpftrace or SystemTap can histogram latencies in a
+ * running process:
+ *
+ *     bpftrace -e 'usdt:./app:sch:mul_entry { @s[tid] = nsecs; }
+ *                  usdt:./app:sch:mul_return /@s[tid]/ {
+ *                    @ns = hist(nsecs - @s[tid]); delete(@s[tid]); }'
+ *
+ * An unattached probe is a single nop; without the macro, or without the
+ * header, the probes expand to nothing at all.
+ */
+
+#ifndef SCH_INCLUDE_PROBES_HPP_
+#define SCH_INCLUDE_PROBES_HPP_
+
+#include <utility>
+
+#if defined(SCH_ENABLE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SCH_HAVE_USDT 1
+#endif
+#endif
+
+#ifdef SCH_HAVE_USDT
+
+namespace sch::detail {
+
+/// runs a callable when it goes out of scope, on every return path
+template <typename F> class ProbeExit {
+public:
+  explicit ProbeExit(F f) : _f{std::move(f)} {}
+  ~ProbeExit() { _f(); }
+  ProbeExit(const ProbeExit &) = delete;
+  ProbeExit &operator=(const ProbeExit &) = delete;
+
+private:
+  F _f;
+};
+
+} // namespace sch::detail
+
+/// fire sch:<op>_entry now and sch:<op>_return when the scope ends
+#define SCH_PROBE_SCOPE(op, arg1, arg2)                                        \
+  DTRACE_PROBE2(sch, op##_entry, arg1, arg2);                                  \
+  const ::sch::detail::ProbeExit sch_probe_exit_ {                             \
+    [&] { DTRACE_PROBE2(sch, op##_return, arg1, arg2); }                       \
+  }
+
+#else
+
+#define SCH_PROBE_SCOPE(op, arg1, arg2) static_cast<void>(0)
+
+#endif // SCH_HAVE_USDT
+
+#endif // SCH_INCLUDE_PROBES_HPP_
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file random.hpp
+ * @brief Uniformly random BigInts, for benchmarks and probabilistic
+ *        algorithms
+ *
+ * The limbs are drawn straight from a 64-bit generator, one word per limb,
+ * rejecting the few words at the top of the range that would bias a limb
+ * towards small values; nothing goes through decimal strings. Each function
+ * takes any UniformRandomBitGenerator (std::mt19937_64 is the natural
+ * choice), or uses a thread-local std::mt19937_64 seeded from
+ * std::random_device.
+ */
+
+#ifndef SCH_INCLUDE_RANDOM_HPP_
+#define SCH_INCLUDE_RANDOM_HPP_
+
+#include "BigInt.hpp"
+#include "cache.hpp"
+#include "limbs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace sch {
+
+namespace detail {
+
+/// @return 64 uniformly random bits
+template <typename URBG> std::uint64_t random_word(URBG &rng) {
+  if constexpr (URBG::min() == 0 &&
+                URBG::max() == std::numeric_limits<std::uint64_t>::max()) {
+    return rng();
+  } else {
+    return std::uniform_int_distribution<std::uint64_t>{}(rng);
+  }
+}
+
+/// @return a uniformly random value in [0, n), 0 < n <= BASE
+template <typename URBG>
+std::uint64_t random_limb(URBG &rng, const std::uint64_t n = LIMB_BASE) {
+  // the largest multiple of n that fits, so that w % n is unbiased
+  const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() -
+                              std::numeric_limits<std::uint64_t>::max() % n;
+  std::uint64_t w = random_word(rng);
+  while (w >= limit) {
+    w = random_word(rng);
+  }
+  return w % n;
+}
+
+/// the generator used when none is given
+inline std::mt19937_64 &default_rng() {
+  thread_local std::mt19937_64 rng{[] {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32U) | device();
+  }()};
+  return rng;
+}
+
+} // namespace detail
+
+/**
+ * @return a uniformly random value in [0, bound)
+ * @throws std::invalid_argument if `bound` is not positive.
+ */
+template <typename URBG>
+[[nodiscard]] BigInt random_below(const BigInt &bound, URBG &rng) {
+  if (bound <= 0) {
+    throw std::invalid_argument("sch::random_below() : bound must be positive");
+  }
+  const detail::Limbs &b = bound.limbs();
+  const std::size_t k = b.size();
+  detail::Limbs v(k);
+  // from the top down, starting over as soon as the prefix exceeds bound's;
+  // each attempt succeeds with probability at least 1/2
+  for (bool restart = true; restart;) {
+    restart = false;
+    v[k - 1] = detail::random_limb(rng, b[k - 1] + 1);
+    bool below = v[k - 1] < b[k - 1]; // the prefix is less than bound's
+    for (std::size_t i = k - 1; i-- > 0;) {
+      v[i] = detail::random_limb(rng);
+      if (!below) {
+        if (v[i] > b[i]) {
+          restart = true;
+          break;
+        }
+        below = v[i] < b[i];
+      }
+    }
+    restart = restart || !below; // equal to bound
+  }
+  detail::trim(v);
+  return BigInt{std::move(v)};
+}
+
+/// @return a uniformly random value in [0, 2^bits)
+template <typename URBG>
+[[nodiscard]] BigInt random_bits(const std::size_t bits, URBG &rng) {
+  return random_below(*constants().power(2, bits), rng);
+}
+
+/**
+ * @return a uniformly random number of exactly `digits` decimal digits, in
+ *         [10^(digits - 1), 10^digits); 0 if `digits` is 0
+ */
+template <typename URBG>
+[[nodiscard]] BigInt random_digits(const std::size_t digits, URBG &rng) {
+  if (digits == 0) {
+    return 0;
+  }
+  const auto exp = static_cast<std::size_t>(BigInt::EXP);
+  const std::size_t k = (digits + exp - 1) / exp;
+  detail::Limbs v(k);
+  for (std::size_t i = 0; i + 1 < k; ++i) {
+    v[i] = detail::random_limb(rng);
+  }
+  // the top limb has the remaining digits, the first of them nonzero
+  std::uint64_t low = 1;
+  for (std::size_t i = 1; i < digits - (k - 1) * exp; ++i) {
+    low *= 10;
+  }
+  v[k - 1] = low + detail::random_limb(rng, 9 * low);
+  return BigInt{std::move(v)};
+}
+
+/// @return random_below(bound) from the thread's default generator
+[[nodiscard]] inline BigInt random_below(const BigInt &bound) {
+  return random_below(bound, detail::default_rng());
+}
+
+/// @return random_bits(bits) from the thread's default generator
+[[nodiscard]] inline BigInt random_bits(const std::size_t bits) {
+  return random_bits(bits, detail::default_rng());
+}
+
+/// @return random_digits(digits) from the thread's default generator
+[[nodiscard]] inline BigInt random_digits(const std::size_t digits) {
+  return random_digits(digits, detail::default_rng());
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_RANDOM_HPP_
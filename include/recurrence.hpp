@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file recurrence.hpp
+ * @brief Terms of linear recurrences with constant coefficients
+ */
+
+#ifndef SCH_INCLUDE_RECURRENCE_HPP_
+#define SCH_INCLUDE_RECURRENCE_HPP_
+
+#include "BigInt.hpp"
+#include "Poly.hpp"
+#include "parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace sch {
+
+/**
+ * @brief The n-th term of a_k = c_1 a_{k-1} + ... + c_d a_{k-d}.
+ *
+ * Kitamasa's method: a_n = sum r_i a_i, where r(x) = x^n mod f(x) and
+ * f(x) = x^d - c_1 x^{d-1} - ... - c_d is the characteristic polynomial.
+ * x^n is built by repeated squaring, each square a single Kronecker product
+ * followed by a reduction modulo the monic f, so the cost is O(log n)
+ * polynomial products instead of the d^3 log n of matrix powers. The d
+ * products of the final sum are independent and run in parallel.
+ * @tparam T A built-in integral type (signed or unsigned).
+ * @param coeffs c_1, ..., c_d
+ * @param init a_0, ..., a_{d-1}
+ * @param n The index of the wanted term.
+ * @param policy The threads the final products may use.
+ * @return a_n
+ * @throws std::invalid_argument if `coeffs` is empty, `init` has a different
+ *         size, or `n` is negative.
+ */
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+BigInt linear_recurrence(const std::vector<BigInt> &coeffs,
+                         const std::vector<BigInt> &init, const T n,
+                         const ExecutionPolicy policy = par) {
+  if (coeffs.empty() || init.size() != coeffs.size()) {
+    throw std::invalid_argument(
+        "sch::linear_recurrence() : need d coefficients and d initial terms");
+  }
+  if (n < 0) {
+    throw std::invalid_argument("sch::linear_recurrence() : negative index");
+  }
+  const std::size_t d = coeffs.size();
+  const auto index = static_cast<std::uint64_t>(n);
+  if (index < d) {
+    return init[index];
+  }
+
+  std::vector<BigInt> f(d + 1, BigInt{0});
+  f[d] = 1;
+  for (std::size_t i = 0; i < d; ++i) {
+    f[d - 1 - i] = -coeffs[i];
+  }
+  const Poly characteristic{std::move(f)};
+
+  // x^n mod f, from the top bit down
+  Poly r{1};
+  for (int bit = 63 - __builtin_clzll(index); bit >= 0; --bit) {
+    r = r * r % characteristic;
+    if ((index >> static_cast<unsigned>(bit) & 1U) != 0) {
+      std::vector<BigInt> shifted(1, BigInt{0}); // r * x
+      shifted.insert(shifted.end(), r.coeffs().begin(), r.coeffs().end());
+      r = Poly{std::move(shifted)} % characteristic;
+    }
+  }
+
+  const std::vector<BigInt> &weights = r.coeffs();
+  std::vector<BigInt> terms(weights.size());
+  parallel_for(
+      0, weights.size(),
+      [&](const std::size_t i) { terms[i] = weights[i] * init[i]; }, policy);
+  return std::accumulate(terms.begin(), terms.end(), BigInt{0});
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_RECURRENCE_HPP_
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file series.hpp
+ * @brief Binary splitting for hypergeometric series, and the constants built
+ *        on it
+ */
+
+#ifndef SCH_INCLUDE_SERIES_HPP_
+#define SCH_INCLUDE_SERIES_HPP_
+
+#include "BigInt.hpp"
+#include "parallel.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace sch {
+
+/// the sums of one binary-splitting range, see binary_split()
+struct SplitSums {
+  BigInt P; ///< p(first) ... p(last - 1)
+  BigInt Q; ///< q(first) ... q(last - 1)
+  BigInt T; ///< Q * sum a(k) p(first)...p(k) / (q(first)...q(k))
+};
+
+namespace detail {
+
+/// ranges shorter than this are not worth a thread
+inline constexpr std::size_t SPLIT_PARALLEL_MIN = 256;
+
+/**
+ * @return how many levels of the split tree may fork: log2(threads) + 2, so
+ *         that each thread gets about four pieces and stealing can even out
+ *         halves of unequal cost
+ */
+[[nodiscard]] inline unsigned split_depth(const ExecutionPolicy policy) {
+  const unsigned threads = policy.concurrency();
+  if (threads <= 1) {
+    return 0;
+  }
+  unsigned depth = 2;
+  for (unsigned n = threads; n > 1; n /= 2) {
+    ++depth;
+  }
+  return depth;
+}
+
+template <typename PFn, typename QFn, typename AFn>
+SplitSums binary_split(const std::size_t first, // NOLINT recursion
+                       const std::size_t last, const PFn &p, const QFn &q,
+                       const AFn &a, const unsigned depth) {
+  if (last - first == 1) {
+    BigInt pk{p(first)};
+    BigInt tk = BigInt{a(first)} * pk;
+    return {std::move(pk), BigInt{q(first)}, std::move(tk)};
+  }
+
+  const std::size_t mid = first + (last - first) / 2;
+  SplitSums left;
+  SplitSums right;
+  if (depth > 0 && last - first >= SPLIT_PARALLEL_MIN) {
+    parallel_invoke(
+        [&] { left = binary_split(first, mid, p, q, a, depth - 1); },
+        [&] { right = binary_split(mid, last, p, q, a, depth - 1); });
+  } else {
+    left = binary_split(first, mid, p, q, a, 0);
+    right = binary_split(mid, last, p, q, a, 0);
+  }
+
+  // S = S_left + (P_left / Q_left) S_right
+  return {left.P * right.P, left.Q * right.Q,
+          left.T * right.Q + left.P * right.T};
+}
+
+/// ranges this short are multiplied out one factor at a time
+inline constexpr std::uint64_t PRODUCT_LEAF = 16;
+
+/// @return first (first + 1) ... (last - 1), as a balanced product tree
+inline BigInt product_range(const std::uint64_t first, // NOLINT recursion
+                            const std::uint64_t last, const unsigned depth) {
+  if (last - first <= PRODUCT_LEAF) {
+    // gather factors in one word while the run stays below a limb
+    BigInt product{1};
+    std::uint64_t run = 1;
+    for (std::uint64_t k = first; k < last; ++k) {
+      if (run > (BigInt::BASE - 1) / k) {
+        product *= run;
+        run = 1;
+      }
+      run *= k;
+    }
+    return product * run;
+  }
+  const std::uint64_t mid = first + (last - first) / 2;
+  BigInt left;
+  BigInt right;
+  if (depth > 0 && last - first >= SPLIT_PARALLEL_MIN) {
+    parallel_invoke([&] { left = product_range(first, mid, depth - 1); },
+                    [&] { right = product_range(mid, last, depth - 1); });
+  } else {
+    left = product_range(first, mid, 0);
+    right = product_range(mid, last, 0);
+  }
+  return left * right;
+}
+
+/// @return the first n decimal digits of value
+[[nodiscard]] inline std::string leading_digits(const BigInt &value,
+                                                const std::size_t n) {
+  std::string digits = value.to_string();
+  digits.resize(n);
+  return digits;
+}
+
+} // namespace detail
+
+/**
+ * @brief Binary splitting of sum_{k = first}^{last - 1} a(k) p(first)...p(k) /
+ *        (q(first)...q(k)).
+ *
+ * Splitting the range in half and combining with
+ * P = P_l P_r, Q = Q_l Q_r, T = T_l Q_r + P_l T_r turns the sum of many small
+ * fractions into a balanced tree of large products, which is what fast
+ * multiplication is good at. The two halves of the upper levels are evaluated
+ * in parallel.
+ * @param p, q, a Callables taking a std::size_t k and returning a value
+ *        convertible to BigInt; q must not be zero in the range. With a
+ *        parallel policy they are called concurrently.
+ * @param policy The threads the split may use.
+ * @return {P, Q, T}; the sum is T / Q.
+ * @throws std::invalid_argument if the range is empty.
+ */
+template <typename PFn, typename QFn, typename AFn>
+SplitSums binary_split(const std::size_t first, const std::size_t last,
+                       const PFn &p, const QFn &q, const AFn &a,
+                       const ExecutionPolicy policy = par) {
+  if (first >= last) {
+    throw std::invalid_argument("sch::binary_split() : empty range");
+  }
+  const detail::ThreadCap cap{policy};
+  return detail::binary_split(first, last, p, q, a,
+                              detail::split_depth(policy));
+}
+
+/**
+ * @brief The first n decimal digits of pi ("31415..."), by the Chudnovsky
+ *        series.
+ * @throws std::invalid_argument if `n` is zero.
+ */
+[[nodiscard]] inline std::string pi_digits(const std::size_t n,
+                                           const ExecutionPolicy policy = par) {
+  if (n == 0) {
+    throw std::invalid_argument("sch::pi_digits() : no digits requested");
+  }
+  constexpr std::size_t GUARD = 10;
+  const std::size_t digits = n + GUARD;
+  // each term adds log10(640320^3 / 1728) ~ 14.18 digits
+  const std::size_t terms = digits / 14 + 2;
+
+  const BigInt c3_24{"10939058860032000"}; // 640320^3 / 24
+  const auto p = [](const std::size_t k) {
+    if (k == 0) {
+      return BigInt{1};
+    }
+    const BigInt x = BigInt{6 * k - 5} * BigInt{2 * k - 1} * BigInt{6 * k - 1};
+    return -x;
+  };
+  const auto q = [&c3_24](const std::size_t k) {
+    if (k == 0) {
+      return BigInt{1};
+    }
+    const BigInt bk{k};
+    return bk * bk * bk * c3_24;
+  };
+  const auto a = [](const std::size_t k) {
+    return BigInt{13591409} + BigInt{545140134} * BigInt{k};
+  };
+  const SplitSums s = binary_split(0, terms, p, q, a, policy);
+
+  // pi = 426880 sqrt(10005) Q / T
+  const BigInt root = isqrt(BigInt{10005} * pow(BigInt{10}, 2 * digits - 2));
+  return detail::leading_digits(BigInt{426880} * root * s.Q / s.T, n);
+}
+
+/**
+ * @brief The first n decimal digits of e ("27182..."), by sum 1 / k!.
+ * @throws std::invalid_argument if `n` is zero.
+ */
+[[nodiscard]] inline std::string e_digits(const std::size_t n,
+                                          const ExecutionPolicy policy = par) {
+  if (n == 0) {
+    throw std::invalid_argument("sch::e_digits() : no digits requested");
+  }
+  constexpr std::size_t GUARD = 10;
+  const std::size_t digits = n + GUARD;
+
+  // stop once log10(k!) exceeds the digits wanted
+  std::size_t terms = 1;
+  for (double log_fact = 0; log_fact < static_cast<double>(digits) + 1;
+       ++terms) {
+    log_fact += std::log10(static_cast<double>(terms));
+  }
+
+  const SplitSums s = binary_split(
+      0, terms, [](std::size_t) { return 1; },
+      [](const std::size_t k) { return k == 0 ? std::size_t{1} : k; },
+      [](std::size_t) { return 1; }, policy);
+  return detail::leading_digits(pow(BigInt{10}, digits - 1) * s.T / s.Q, n);
+}
+
+/**
+ * @brief n!, as a balanced product tree so that the large products are of
+ *        equal-sized halves; the upper levels are evaluated in parallel.
+ */
+[[nodiscard]] inline BigInt factorial(const std::uint64_t n,
+                                      const ExecutionPolicy policy = par) {
+  if (n < 2) {
+    return BigInt{1};
+  }
+  const detail::ThreadCap cap{policy};
+  return detail::product_range(2, n + 1, detail::split_depth(policy));
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_SERIES_HPP_
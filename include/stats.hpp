@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file stats.hpp
+ * @brief Opt-in allocation and temporary counters for BigInt operations
+ *
+ * Define SCH_ENABLE_STATS (for every translation unit of the program, or with
+ * the SCH_ENABLE_STATS CMake option) to count, per operation, the calls, the
+ * limb allocations and their bytes, and the BigInt constructions, plus the
+ * live and peak limb counts. Without it the hooks are empty inline functions,
+ * limb storage uses std::allocator, and stats() returns zeros.
+ *
+ * Allocations and constructions are charged to the outermost operation in
+ * progress on the calling thread, so the figures for operator/ include the
+ * multiplications it makes; calls are counted for nested operations too.
+ */
+
+#ifndef SCH_INCLUDE_STATS_HPP_
+#define SCH_INCLUDE_STATS_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sch {
+
+/// the operations counted by stats()
+enum class Op : std::uint8_t {
+  other, ///< outside any counted operation
+  construct,
+  to_string,
+  add,
+  sub,
+  mul,
+  div,
+  mod,
+  pow,
+};
+
+inline constexpr std::size_t OP_COUNT = 9;
+
+#ifdef SCH_ENABLE_STATS
+inline constexpr bool STATS_ENABLED = true;
+#else
+inline constexpr bool STATS_ENABLED = false;
+#endif
+
+/// counters of one operation
+struct OpStats {
+  std::uint64_t calls{};
+  std::uint64_t allocations{}; ///< limb buffers allocated
+  std::uint64_t bytes{};       ///< bytes in those buffers
+  std::uint64_t temporaries{}; ///< BigInt objects constructed
+};
+
+/// a snapshot of the counters, see stats()
+struct Stats {
+  std::array<OpStats, OP_COUNT> ops{};
+  std::uint64_t live_limbs{}; ///< limbs allocated and not yet freed
+  std::uint64_t peak_limbs{}; ///< the high-water mark of live_limbs
+
+  [[nodiscard]] const OpStats &operator[](const Op op) const {
+    return ops[static_cast<std::size_t>(op)];
+  }
+
+  /// @return the sum over all operations
+  [[nodiscard]] OpStats total() const {
+    OpStats sum;
+    for (const auto &s : ops) {
+      sum.calls += s.calls;
+      sum.allocations += s.allocations;
+      sum.bytes += s.bytes;
+      sum.temporaries += s.temporaries;
+    }
+    return sum;
+  }
+};
+
+/**
+ * @return the counters accumulated between `before` and `after`; the limb
+ *         counts are those of `after`
+ */
+inline Stats operator-(const Stats &after, const Stats &before) {
+  Stats diff = after;
+  for (std::size_t i = 0; i < OP_COUNT; ++i) {
+    diff.ops[i].calls -= before.ops[i].calls;
+    diff.ops[i].allocations -= before.ops[i].allocations;
+    diff.ops[i].bytes -= before.ops[i].bytes;
+    diff.ops[i].temporaries -= before.ops[i].temporaries;
+  }
+  return diff;
+}
+
+namespace detail {
+
+#ifdef SCH_ENABLE_STATS
+
+/// the live counters behind stats()
+struct StatCounters {
+  struct PerOp {
+    std::atomic<std::uint64_t> calls;
+    std::atomic<std::uint64_t> allocations;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> temporaries;
+  };
+  std::array<PerOp, OP_COUNT> ops;
+  std::atomic<std::uint64_t> live_limbs;
+  std::atomic<std::uint64_t> peak_limbs;
+};
+
+inline StatCounters stat_counters{};
+
+/// the outermost operation in progress on this thread, and the nesting depth
+inline thread_local Op current_op = Op::other;
+inline thread_local unsigned op_depth = 0;
+
+inline StatCounters::PerOp &current_counters() {
+  return stat_counters.ops[static_cast<std::size_t>(current_op)];
+}
+
+inline void on_allocate(const std::size_t limbs, const std::size_t bytes) {
+  auto &c = current_counters();
+  c.allocations.fetch_add(1, std::memory_order_relaxed);
+  c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  const std::uint64_t live =
+      stat_counters.live_limbs.fetch_add(limbs, std::memory_order_relaxed) +
+      limbs;
+  std::uint64_t peak = stat_counters.peak_limbs.load(std::memory_order_relaxed);
+  while (live > peak && !stat_counters.peak_limbs.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+inline void on_deallocate(const std::size_t limbs) {
+  stat_counters.live_limbs.fetch_sub(limbs, std::memory_order_relaxed);
+}
+
+inline void on_construct() {
+  current_counters().temporaries.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// marks the extent of one counted operation
+class OpScope {
+public:
+  explicit OpScope(const Op op) {
+    if (op_depth++ == 0) {
+      current_op = op;
+    }
+    stat_counters.ops[static_cast<std::size_t>(op)].calls.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  ~OpScope() {
+    if (--op_depth == 0) {
+      current_op = Op::other;
+    }
+  }
+  OpScope(const OpScope &) = delete;
+  OpScope &operator=(const OpScope &) = delete;
+};
+
+/// std::allocator that reports to the counters
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &) noexcept {} // NOLINT
+
+  T *allocate(const std::size_t n) {
+    on_allocate(n * sizeof(T) / sizeof(std::uint64_t), n * sizeof(T));
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, const std::size_t n) noexcept {
+    on_deallocate(n * sizeof(T) / sizeof(std::uint64_t));
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+template <typename T> using LimbAllocator = CountingAllocator<T>;
+
+#else
+
+inline void on_construct() {}
+
+/// marks the extent of one counted operation
+class OpScope {
+public:
+  explicit OpScope(Op /*op*/) {}
+};
+
+template <typename T> using LimbAllocator = std::allocator<T>;
+
+#endif // SCH_ENABLE_STATS
+
+} // namespace detail
+
+/// @return a snapshot of the counters; all zero without SCH_ENABLE_STATS
+[[nodiscard]] inline Stats stats() {
+  Stats s;
+#ifdef SCH_ENABLE_STATS
+  const auto &c = detail::stat_counters;
+  for (std::size_t i = 0; i < OP_COUNT; ++i) {
+    s.ops[i].calls = c.ops[i].calls.load(std::memory_order_relaxed);
+    s.ops[i].allocations = c.ops[i].allocations.load(std::memory_order_relaxed);
+    s.ops[i].bytes = c.ops[i].bytes.load(std::memory_order_relaxed);
+    s.ops[i].temporaries = c.ops[i].temporaries.load(std::memory_order_relaxed);
+  }
+  s.live_limbs = c.live_limbs.load(std::memory_order_relaxed);
+  s.peak_limbs = c.peak_limbs.load(std::memory_order_relaxed);
+#endif
+  return s;
+}
+
+/// zero the per-operation counters and restart the peak from the live count
+inline void reset_stats() {
+#ifdef SCH_ENABLE_STATS
+  auto &c = detail::stat_counters;
+  for (auto &op : c.ops) {
+    op.calls.store(0, std::memory_order_relaxed);
+    op.allocations.store(0, std::memory_order_relaxed);
+    op.bytes.store(0, std::memory_order_relaxed);
+    op.temporaries.store(0, std::memory_order_relaxed);
+  }
+  c.peak_limbs.store(c.live_limbs.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+#endif
+}
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_STATS_HPP_
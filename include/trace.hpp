@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 Drake Manzanares
+ * Distributed under the MIT License.
+ */
+
+/**
+ * @file trace.hpp
+ * @brief Opt-in tracing of which algorithm tier serves each operation
+ *
+ * Define SCH_ENABLE_TRACE (or use the SCH_ENABLE_TRACE CMake option) and every
+ * multiplication, squaring, division and reciprocal reports a TraceEvent: the
+ * tier that ran, the operand sizes in limbs, the nesting depth among traced
+ * calls, and the elapsed nanoseconds. Events go to the callback installed with
+ * set_trace_callback(); the default pushes them into trace_ring(), a bounded
+ * lock-free queue that drops events rather than block when it is full.
+ *
+ * Without the macro the hooks are empty and cost nothing; the types and the
+ * ring remain available, but no events are produced.
+ */
+
+#ifndef SCH_INCLUDE_TRACE_HPP_
+#define SCH_INCLUDE_TRACE_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace sch {
+
+/// the algorithm tiers reported by the trace hooks
+enum class Algo : std::uint8_t {
+  mul_schoolbook,
+  mul_karatsuba,
+  sqr_schoolbook,
+  sqr_karatsuba,
+  div_1,      ///< single-limb divisor
+  div_knuth,  ///< Knuth's algorithm D
+  div_newton, ///< through a Newton reciprocal
+  reciprocal, ///< one level of the Newton reciprocal
+};
+
+inline constexpr std::size_t ALGO_COUNT = 8;
+
+/// @return the name of a tier, e.g. "mul_karatsuba"
+[[nodiscard]] constexpr const char *algo_name(const Algo algo) {
+  constexpr std::array<const char *, ALGO_COUNT> names{
+      "mul_schoolbook", "mul_karatsuba", "sqr_schoolbook", "sqr_karatsuba",
+      "div_1",          "div_knuth",     "div_newton",     "reciprocal"};
+  return names[static_cast<std::size_t>(algo)];
+}
+
+#ifdef SCH_ENABLE_TRACE
+inline constexpr bool TRACE_ENABLED = true;
+#else
+inline constexpr bool TRACE_ENABLED = false;
+#endif
+
+/// one traced call
+struct TraceEvent {
+  Algo algo;
+  std::uint32_t depth;     ///< traced calls enclosing this one on its thread
+  std::size_t lhs_limbs;   ///< the larger operand, or the dividend
+  std::size_t rhs_limbs;   ///< the smaller operand, or the divisor
+  std::uint64_t nanoseconds;
+};
+
+/**
+ * @brief A bounded multi-producer multi-consumer queue of TraceEvents.
+ *
+ * Vyukov's array queue: each slot carries a sequence number that tells
+ * producers and consumers whether it is free or full, so that push and pop
+ * only ever compare-and-swap a position counter. A push into a full ring is
+ * dropped and counted.
+ * @tparam N The capacity, a power of two.
+ */
+template <std::size_t N> class TraceRing {
+  static_assert(N > 1 && (N & (N - 1)) == 0, "capacity must be a power of 2");
+
+public:
+  TraceRing() {
+    for (std::size_t i = 0; i < N; ++i) {
+      _slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  TraceRing(const TraceRing &) = delete;
+  TraceRing &operator=(const TraceRing &) = delete;
+
+  /// @return false, counting a drop, if the ring is full
+  bool push(const TraceEvent &event) {
+    std::size_t pos = _tail.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = _slots[pos & (N - 1)];
+      const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          slot.event = event;
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @return false if the ring is empty
+  bool pop(TraceEvent &event) {
+    std::size_t pos = _head.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = _slots[pos & (N - 1)];
+      const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (_head.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          event = slot.event;
+          slot.seq.store(pos + N, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// pop every event in the ring and pass it to f
+  template <typename F> void drain(F &&f) {
+    TraceEvent event{};
+    while (pop(event)) {
+      f(event);
+    }
+  }
+
+  /// @return the number of events dropped because the ring was full
+  [[nodiscard]] std::uint64_t dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+  static constexpr std::size_t capacity() { return N; }
+
+private:
+  struct Slot {
+    std::atomic<std::size_t> seq;
+    TraceEvent event;
+  };
+
+  std::array<Slot, N> _slots;
+  alignas(64) std::atomic<std::size_t> _head{0};
+  alignas(64) std::atomic<std::size_t> _tail{0};
+  std::atomic<std::uint64_t> _dropped{0};
+};
+
+inline constexpr std::size_t TRACE_RING_CAPACITY = 4096;
+
+/// @return the ring the default callback records into
+[[nodiscard]] inline TraceRing<TRACE_RING_CAPACITY> &trace_ring() {
+  static TraceRing<TRACE_RING_CAPACITY> ring;
+  return ring;
+}
+
+using TraceCallback = void (*)(const TraceEvent &);
+
+namespace detail {
+
+inline void record_to_ring(const TraceEvent &event) {
+  trace_ring().push(event);
+}
+
+inline std::atomic<TraceCallback> trace_callback{&record_to_ring};
+
+} // namespace detail
+
+/**
+ * @brief Route trace events to `callback`, which may be called concurrently
+ *        from any thread doing arithmetic; nullptr discards them.
+ * @return the previous callback
+ */
+inline TraceCallback set_trace_callback(const TraceCallback callback) {
+  return detail::trace_callback.exchange(callback, std::memory_order_acq_rel);
+}
+
+/// @return the callback that records into trace_ring()
+[[nodiscard]] inline TraceCallback default_trace_callback() {
+  return &detail::record_to_ring;
+}
+
+namespace detail {
+
+#ifdef SCH_ENABLE_TRACE
+
+inline thread_local std::uint32_t trace_depth = 0;
+
+/// times one traced call and reports it when it ends
+class TraceScope {
+public:
+  TraceScope(const Algo algo, const std::size_t lhs_limbs,
+             const std::size_t rhs_limbs)
+      : _algo{algo}, _depth{trace_depth++}, _lhs{lhs_limbs}, _rhs{rhs_limbs},
+        _start{std::chrono::steady_clock::now()} {}
+  ~TraceScope() {
+    const auto elapsed = std::chrono::steady_clock::now() - _start;
+    --trace_depth;
+    if (const TraceCallback callback =
+            trace_callback.load(std::memory_order_acquire)) {
+      callback(TraceEvent{
+          _algo, _depth, _lhs, _rhs,
+          static_cast<std::uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                  .count())});
+    }
+  }
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  Algo _algo;
+  std::uint32_t _depth;
+  std::size_t _lhs;
+  std::size_t _rhs;
+  std::chrono::steady_clock::time_point _start;
+};
+
+#else
+
+/// times one traced call and reports it when it ends
+class TraceScope {
+public:
+  TraceScope(Algo /*algo*/, std::size_t /*lhs_limbs*/,
+             std::size_t /*rhs_limbs*/) {}
+};
+
+#endif // SCH_ENABLE_TRACE
+
+} // namespace detail
+
+} // namespace sch
+
+#endif // SCH_INCLUDE_TRACE_HPP_
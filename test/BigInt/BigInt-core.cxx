@@ -145,6 +145,33 @@ TEST_CASE("division") {
   }
 }
 
+TEST_CASE("division through a Newton reciprocal") {
+  for (int i = 0; i < 4; ++i) {
+    std::string str = random_string(27000, 60000); // 1500 limbs and up
+    remove_leading_zeros(str);
+    const sch::BigInt b{str};
+    const sch::BigInt a = b * b + b - 1 + sch::BigInt{random_string(1, 9000)};
+    const sch::BigInt q = a / b;
+    const sch::BigInt r = a % b;
+    CHECK(q * b + r == a);
+    CHECK(r >= 0);
+    CHECK(r < b);
+  }
+}
+
+TEST_CASE("division with zero limbs") {
+  // the running remainder loses its high limbs once they reach zero
+  const sch::BigInt ten_19{"10000000000000000000"};
+  CHECK(ten_19 / 1 == ten_19);
+  CHECK(sch::BigInt{"1" + std::string(54, '0')} / 8 ==
+        sch::BigInt{"125" + std::string(51, '0')});
+  CHECK(sch::BigInt{"1" + std::string(54, '0')} % 8 == 0);
+  CHECK(sch::BigInt{"1" + std::string(108, '0')} /
+            sch::BigInt{std::string(36, '9') + "5"} ==
+        sch::BigInt{"1" + std::string(36, '0') + "5" +
+                    std::string(34, '0')});
+}
+
 TEST_CASE("modulo") {
   for (int i = 0; i < 50; ++i) {
     sch::BigInt bint[2];
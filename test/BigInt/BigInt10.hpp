@@ -14,7 +14,6 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <execution>
 #include <numeric>
 #include <stdexcept>
 #include <string>
@@ -686,8 +685,8 @@ inline BigInt10 BigInt10::longMultiplication(const BigInt10 &bottom,
     ++latest_prod; // moving on
     carry = 0;     // reset for the next intermediate product
   }
-  final_product = std::reduce(std::execution::par, products.begin(),
-                              products.end(), BigInt10{});
+  final_product =
+      std::accumulate(products.begin(), products.end(), BigInt10{});
   final_product._Sign10 =
       bottom._Sign10 == top._Sign10 ? Sign10::positive : Sign10::negative;
   final_product.normalize();
@@ -0,0 +1,119 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "async.hpp"
+#include "parallel.hpp"
+#include "series.hpp"
+
+namespace big_int_test {
+
+/// restores the default executor when the test ends, even on failure
+struct ExecutorGuard {
+  ExecutorGuard() = default;
+  ~ExecutorGuard() { sch::set_executor(nullptr); }
+  ExecutorGuard(const ExecutorGuard &) = delete;
+  ExecutorGuard &operator=(const ExecutorGuard &) = delete;
+};
+
+TEST_CASE("factorial") {
+  CHECK(sch::factorial(0) == 1);
+  CHECK(sch::factorial(1) == 1);
+  CHECK(sch::factorial(5) == 120);
+  CHECK(sch::factorial(25) == sch::BigInt{"15511210043330985984000000"});
+  sch::BigInt f{1};
+  for (unsigned k = 2; k <= 1000; ++k) {
+    f *= k;
+  }
+  CHECK(sch::factorial(1000) == f);
+  CHECK(sch::factorial(1000, sch::seq) == f);
+}
+
+TEST_CASE("async results") {
+  const ExecutorGuard guard;
+  for (const unsigned threads : {1U, 3U}) {
+    sch::set_num_threads(threads);
+    const sch::BigInt a{std::string(5000, '7')};
+    const sch::BigInt b{std::string(3000, '3')};
+    auto mul = sch::async::mul(a, b);
+    auto sqr = sch::async::mul(a, a);
+    auto div = sch::async::div(a, b);
+    auto pow = sch::async::pow(sch::BigInt{-3}, 1001);
+    auto fact = sch::async::factorial(500);
+    CHECK(mul.get() == a * b);
+    CHECK(sqr.get() == a * a);
+    CHECK(div.get() == a / b);
+    CHECK(pow.get() == sch::pow(sch::BigInt{-3}, 1001));
+    CHECK(fact.get() == sch::factorial(500));
+    CHECK(mul.progress() == 1);
+  }
+}
+
+TEST_CASE("async errors") {
+  auto div = sch::async::div(sch::BigInt{1}, sch::BigInt{0});
+  CHECK_THROWS_AS(div.get(), std::runtime_error);
+}
+
+TEST_CASE("async progress") {
+  std::vector<double> seen;
+  const sch::BigInt a{std::string(20000, '9')};
+  auto mul = sch::async::mul(a, a + 1, {},
+                             [&seen](const double p) { seen.push_back(p); });
+  CHECK(mul.get() == a * (a + 1));
+  REQUIRE(seen.size() > 10);
+  CHECK(seen.back() == 1);
+  for (std::size_t i = 1; i < seen.size(); ++i) {
+    CHECK(seen[i] > seen[i - 1]);
+  }
+}
+
+TEST_CASE("async cancellation") {
+  const ExecutorGuard guard;
+  const unsigned threads = GENERATE(1U, 4U);
+  sch::set_num_threads(threads);
+
+  SECTION("before the start") {
+    sch::CancellationToken token;
+    token.cancel();
+    auto mul = sch::async::mul(sch::BigInt{2}, sch::BigInt{3}, token);
+    CHECK_THROWS_AS(mul.get(), sch::OperationCancelled);
+  }
+
+  SECTION("from the progress callback") {
+    sch::CancellationToken token;
+    auto fact = sch::async::factorial(
+        200000, token, [token](const double p) {
+          if (p > 0.1) {
+            token.cancel();
+          }
+        });
+    CHECK_THROWS_AS(fact.get(), sch::OperationCancelled);
+    CHECK(fact.progress() < 1);
+  }
+
+  SECTION("one token stops several operations") {
+    sch::CancellationToken token;
+    const sch::BigInt a{std::string(200000, '5')};
+    auto pow = sch::async::pow(sch::BigInt{3}, 50'000'000, token);
+    auto div = sch::async::div(a * a, a - 1, token);
+    pow.cancel();
+    CHECK(pow.wait_for(std::chrono::seconds{30}) ==
+          std::future_status::ready);
+    CHECK_THROWS_AS(pow.get(), sch::OperationCancelled);
+    CHECK_THROWS_AS(div.get(), sch::OperationCancelled);
+  }
+}
+
+TEST_CASE("synchronous operations ignore other threads' tokens") {
+  sch::CancellationToken token;
+  token.cancel();
+  auto cancelled = sch::async::mul(sch::BigInt{2}, sch::BigInt{3}, token);
+  CHECK_THROWS_AS(cancelled.get(), sch::OperationCancelled);
+  const sch::BigInt a{std::string(2000, '8')};
+  CHECK_NOTHROW(a * a);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,184 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "batch.hpp"
+#include "helpers.hpp"
+#include "parallel.hpp"
+
+namespace big_int_test {
+
+/// restores the default pool at the end of a test
+struct PoolGuard {
+  explicit PoolGuard(const unsigned threads) { sch::set_num_threads(threads); }
+  ~PoolGuard() { sch::set_executor(nullptr); }
+  PoolGuard(const PoolGuard &) = delete;
+  PoolGuard &operator=(const PoolGuard &) = delete;
+};
+
+/// runs every task inline, counting them
+class CountingExecutor final : public sch::Executor {
+public:
+  void submit(std::function<void()> task) override {
+    ++submitted;
+    task();
+  }
+  [[nodiscard]] unsigned concurrency() const override { return 4; }
+  std::atomic<std::size_t> submitted{0};
+};
+
+/// @return base^exp mod m in [0, m), by square-and-multiply on BigInts
+inline sch::BigInt reference_powm(sch::BigInt base, sch::BigInt exp,
+                                  const sch::BigInt &m) {
+  sch::BigInt res{1};
+  base = (base % m + m) % m;
+  while (exp > 0) {
+    if (exp % 2 == 1) {
+      res = res * base % m;
+    }
+    base = base * base % m;
+    exp = exp / 2;
+  }
+  return res % m;
+}
+
+/// many small operands and a few large ones, in no particular order
+inline std::vector<sch::BigInt> mixed_operands(const std::size_t n) {
+  std::vector<sch::BigInt> v;
+  for (std::size_t i = 0; i < n; ++i) {
+    v.push_back(i % 25 == 7 ? random_big_int(20000, 60000)
+                            : random_big_int(1, 300));
+  }
+  return v;
+}
+
+TEST_CASE("parallel products") {
+  const unsigned threads = GENERATE(1U, 4U);
+  const PoolGuard pool{threads};
+  for (const auto &[an, bn] : {std::pair{50000, 50000}, std::pair{90000, 20000},
+                               std::pair{20000, 90000}}) {
+    const sch::BigInt a = random_big_int(an, an);
+    const sch::BigInt b = random_big_int(bn, bn);
+    CHECK(sch::detail::mul_parallel(a, b, sch::par) == a * b);
+    CHECK(sch::detail::mul_parallel(a, a, sch::par) == a * a);
+  }
+  const sch::BigInt base = random_big_int(500, 500);
+  CHECK(sch::detail::pow_parallel(base, 77, sch::par) == sch::pow(base, 77));
+}
+
+TEST_CASE("batch::multiply") {
+  const unsigned threads = GENERATE(1U, 4U);
+  const PoolGuard pool{threads};
+  const std::vector<sch::BigInt> a = mixed_operands(200);
+  const std::vector<sch::BigInt> b = mixed_operands(200);
+  std::vector<std::pair<const sch::BigInt &, const sch::BigInt &>> tasks;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    tasks.emplace_back(a[i], b[(i * 7) % b.size()]);
+  }
+  const std::vector<sch::BigInt> products = sch::batch::multiply(tasks);
+  REQUIRE(products.size() == tasks.size());
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    CHECK(products[i] == tasks[i].first * tasks[i].second);
+  }
+  CHECK(sch::batch::multiply(tasks, sch::seq) == products);
+
+  const std::vector<std::pair<const sch::BigInt &, const sch::BigInt &>> none;
+  CHECK(sch::batch::multiply(none).empty());
+}
+
+TEST_CASE("batch::divide") {
+  const unsigned threads = GENERATE(1U, 4U);
+  const PoolGuard pool{threads};
+  const std::vector<sch::BigInt> a = mixed_operands(150);
+  std::vector<sch::BigInt> b;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    sch::BigInt d = random_big_int(1, i % 3 == 0 ? 30000 : 100);
+    b.push_back(d == 0 ? sch::BigInt{7} : d);
+  }
+  std::vector<std::tuple<sch::BigInt, sch::BigInt>> tasks;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    tasks.emplace_back(a[i], b[i]);
+  }
+  tasks.emplace_back(0, -5);
+  const auto results = sch::batch::divide(tasks);
+  REQUIRE(results.size() == tasks.size());
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    const auto &[x, y] = tasks[i];
+    CHECK(results[i].first == x / y);
+    CHECK(results[i].second == x % y);
+  }
+
+  tasks.emplace_back(1, 0);
+  CHECK_THROWS_AS(sch::batch::divide(tasks), std::runtime_error);
+}
+
+TEST_CASE("large tasks without a parallel kernel share the threads") {
+  const PoolGuard pool{1};
+  const auto counting = std::make_shared<CountingExecutor>();
+  sch::set_executor(counting);
+
+  // each costs half the batch, more than an even share of 4 threads
+  const sch::BigInt a = random_big_int(40000, 40000);
+  const sch::BigInt b = random_big_int(20000, 20000);
+  const std::vector<std::pair<sch::BigInt, sch::BigInt>> tasks{{a, b},
+                                                               {b, a}};
+  const auto q = sch::batch::divide(tasks);
+  CHECK(counting->submitted > 0);
+  CHECK(q[0].first == a / b);
+  CHECK(q[1].second == b % a);
+
+  counting->submitted = 0;
+  const sch::BigInt m = sch::BigInt{"1" + std::string(600, '0')} + 7;
+  const sch::BigInt exp = sch::BigInt{"9" + std::string(300, '1')};
+  const std::vector<std::tuple<sch::BigInt, sch::BigInt, sch::BigInt>>
+      triples{{a, exp, m}, {b, exp, m}};
+  const std::vector<sch::BigInt> r = sch::batch::powm(triples);
+  CHECK(counting->submitted > 0);
+  CHECK(r[0] == reference_powm(a, exp, m));
+  CHECK(r[1] == reference_powm(b, exp, m));
+}
+
+TEST_CASE("batch::pow and batch::powm") {
+  const unsigned threads = GENERATE(1U, 4U);
+  const PoolGuard pool{threads};
+
+  std::vector<std::pair<sch::BigInt, int>> powers;
+  for (int i = 0; i < 60; ++i) {
+    powers.emplace_back(random_big_int(1, 60), i % 13 == 0 ? 3000 : i % 9);
+  }
+  powers.emplace_back(0, 0);
+  powers.emplace_back(0, 5);
+  const std::vector<sch::BigInt> p = sch::batch::pow(powers);
+  for (std::size_t i = 0; i < powers.size(); ++i) {
+    CHECK(p[i] == sch::pow(powers[i].first, powers[i].second));
+  }
+  powers.emplace_back(2, -1);
+  CHECK_THROWS_AS(sch::batch::pow(powers), std::invalid_argument);
+
+  std::vector<std::tuple<sch::BigInt, sch::BigInt, sch::BigInt>> triples;
+  for (int i = 0; i < 40; ++i) {
+    sch::BigInt m = random_big_int(1, i % 10 == 0 ? 2000 : 60);
+    m = m < 0 ? -m : m;
+    triples.emplace_back(random_big_int(1, 80), sch::BigInt{i * i},
+                         m + 2);
+  }
+  triples.emplace_back(-3, sch::BigInt{"123456789012345678901234567890"},
+                       sch::BigInt{"1000000007"});
+  const std::vector<sch::BigInt> r = sch::batch::powm(triples);
+  for (std::size_t i = 0; i < triples.size(); ++i) {
+    const auto &[base, exp, mod] = triples[i];
+    CHECK(r[i] == reference_powm(base, exp, mod));
+  }
+  triples.emplace_back(2, 5, 1);
+  CHECK_THROWS_AS(sch::batch::powm(triples), std::invalid_argument);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,89 @@
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "LimbBatch.hpp"
+#include "helpers.hpp"
+
+namespace big_int_test {
+
+/// @return a random value of up to `limbs` limbs, often with runs of nines
+inline sch::BigInt random_limbs(const std::size_t limbs) {
+  const std::size_t digits = 18 * limbs;
+  std::string str = random_in_range(0, 3) == 0
+                        ? std::string(random_in_range(1, digits), '9')
+                        : random_string(1, digits);
+  remove_leading_zeros(str);
+  return sch::BigInt{str};
+}
+
+template <std::size_t N> sch::LimbBatch<N> random_batch(const std::size_t n) {
+  sch::LimbBatch<N> batch;
+  for (std::size_t i = 0; i < n; ++i) {
+    batch.push_back(random_limbs(N));
+  }
+  return batch;
+}
+
+TEMPLATE_TEST_CASE_SIG("LimbBatch arithmetic", "", ((std::size_t N), N), 1, 2,
+                       3, 4, 8, 16) {
+  const std::size_t n = 700; // more than one chunk, and a partial one
+  const sch::LimbBatch<N> a = random_batch<N>(n);
+  const sch::LimbBatch<N> b = random_batch<N>(n);
+  const sch::BigInt wrap = sch::pow(sch::BigInt{10}, 18 * N);
+
+  const sch::LimbBatch<N> sum = a + b;
+  const sch::LimbBatch<N> difference = a - b;
+  const sch::LimbBatch<2 * N> product = a * b;
+  const std::vector<int> order = compare(a, b);
+  for (std::size_t i = 0; i < n; ++i) {
+    const sch::BigInt x = a.get(i);
+    const sch::BigInt y = b.get(i);
+    CHECK(sum.get(i) == (x + y) % wrap);
+    CHECK(difference.get(i) == (x - y + wrap) % wrap);
+    CHECK(product.get(i) == x * y);
+    CHECK(order[i] == (x < y ? -1 : x == y ? 0 : 1));
+  }
+  CHECK(compare(a, a) == std::vector<int>(n, 0));
+
+  for (std::size_t m_limbs = 1; m_limbs <= N; ++m_limbs) {
+    for (const sch::BigInt &m :
+         {random_limbs(m_limbs) / 2 + 1,
+          sch::pow(sch::BigInt{10}, 18 * m_limbs) - 1,
+          sch::pow(sch::BigInt{10}, 18 * (m_limbs - 1)) + 1}) {
+      const sch::LimbBatch<N> r = a % m;
+      for (std::size_t i = 0; i < n; ++i) {
+        CHECK(r.get(i) == a.get(i) % m);
+      }
+    }
+  }
+}
+
+TEST_CASE("LimbBatch edge cases") {
+  sch::LimbBatch<2> a{0, sch::BigInt{"999999999999999999999999999999999999"},
+                      sch::BigInt{"1000000000000000000"}};
+  sch::LimbBatch<2> b{1, 1, 1};
+  CHECK(a.size() == 3);
+  CHECK((a + b).get(1) == 0);
+  CHECK((a - b).get(0) == sch::BigInt{"999999999999999999999999999999999999"});
+  CHECK((a - b).get(2) == sch::BigInt{"999999999999999999"});
+  CHECK((a * a).get(1) == a.get(1) * a.get(1));
+
+  a.set(0, 42);
+  CHECK(a.get(0) == 42);
+  CHECK(sch::LimbBatch<3>{}.empty());
+  CHECK((sch::LimbBatch<3>{} + sch::LimbBatch<3>{}).empty());
+
+  CHECK_THROWS_AS(a.push_back(-1), std::invalid_argument);
+  CHECK_THROWS_AS(a.set(0, sch::pow(sch::BigInt{10}, 36)),
+                  std::invalid_argument);
+  CHECK_THROWS_AS(a + sch::LimbBatch<2>{1}, std::invalid_argument);
+  CHECK_THROWS_AS(compare(a, sch::LimbBatch<2>{}), std::invalid_argument);
+  CHECK_THROWS_AS(a % 0, std::invalid_argument);
+  CHECK_THROWS_AS(a % sch::pow(sch::BigInt{10}, 36), std::invalid_argument);
+}
+
+} // namespace big_int_test
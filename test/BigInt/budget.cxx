@@ -0,0 +1,164 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "async.hpp"
+#include "batch.hpp"
+#include "budget.hpp"
+#include "dot.hpp"
+
+namespace big_int_test {
+
+namespace {
+
+template <typename F> sch::Resource exceeded(const F &f) {
+  try {
+    f();
+  } catch (const sch::BudgetExceeded &e) {
+    return e.resource();
+  }
+  FAIL("no BudgetExceeded");
+  return {};
+}
+
+sch::Budget digits(const std::size_t n) {
+  sch::Budget b;
+  b.max_digits = n;
+  return b;
+}
+
+sch::Budget limbs(const std::size_t n) {
+  sch::Budget b;
+  b.max_limbs = n;
+  return b;
+}
+
+sch::Budget work(const double w) {
+  sch::Budget b;
+  b.max_work = w;
+  return b;
+}
+
+} // namespace
+
+TEST_CASE("budget limits") {
+  const sch::BigInt big = sch::pow(sch::BigInt{10}, 18 * 1000);
+  const sch::BigInt wide = big * big + 1; // 2001 limbs, made before a budget
+
+  SECTION("digits") {
+    const sch::BudgetScope scope{digits(100)};
+    CHECK(sch::BigInt{std::string(100, '9')} > 0);
+    CHECK(sch::BigInt{"-" + std::string(100, '9')} < 0);
+    CHECK(exceeded([] { sch::BigInt{std::string(101, '9')}; }) ==
+          sch::Resource::digits);
+  }
+
+  SECTION("limbs") {
+    const sch::BudgetScope scope{limbs(1500)};
+    CHECK((big * 1000).limbs().size() == 1001);
+    CHECK_THROWS_AS(big * big, sch::BudgetExceeded);
+    CHECK_THROWS_AS(sch::pow(big, 2), sch::BudgetExceeded);
+    CHECK_THROWS_AS(sch::BigInt{std::string(18 * 1500 + 1, '1')},
+                    sch::BudgetExceeded);
+    sch::BigInt acc{1};
+    CHECK_THROWS_AS(sch::fma(acc, big, big), sch::BudgetExceeded);
+    CHECK(acc == 1);
+    const std::vector<std::tuple<sch::BigInt, sch::BigInt, sch::BigInt>>
+        huge_modulus{{sch::BigInt{3}, sch::BigInt{5}, wide}};
+    CHECK(exceeded([&] { (void)sch::batch::powm(huge_modulus); }) ==
+          sch::Resource::limbs);
+    CHECK(exceeded([] { (void)sch::pow(sch::BigInt{2}, 1'000'000'000); }) ==
+          sch::Resource::limbs);
+    // powers of 1 stay one limb, however large the exponent
+    CHECK(sch::pow(sch::BigInt{-1}, 1'000'000'001) == -1);
+  }
+
+  SECTION("work") {
+    const sch::BudgetScope scope{work(1e5)};
+    CHECK_THROWS_AS(big * big, sch::BudgetExceeded);
+    CHECK_THROWS_AS(big / (sch::pow(sch::BigInt{10}, 18 * 500) + 1),
+                    sch::BudgetExceeded);
+    CHECK_THROWS_AS(big * big % 7, sch::BudgetExceeded);
+    CHECK(big / 7 > 0); // division by one limb is linear
+    const sch::BigInt modulus = sch::pow(sch::BigInt{10}, 18 * 16) + 7;
+    const sch::BigInt exp{std::string(2000, '3')};
+    const std::vector<std::tuple<sch::BigInt, sch::BigInt, sch::BigInt>>
+        powers(16, {sch::BigInt{2}, exp, modulus});
+    CHECK(exceeded([&] { (void)sch::batch::powm(powers); }) ==
+          sch::Resource::work);
+    CHECK(sch::divexact(big, sch::BigInt{8}) * 8 == big);
+    try {
+      (void)(big * big);
+    } catch (const sch::BudgetExceeded &e) {
+      CHECK(e.resource() == sch::Resource::work);
+      CHECK(e.needed() > e.limit());
+      CHECK(e.limit() == 1e5);
+    }
+  }
+}
+
+TEST_CASE("budget scope and thread") {
+  CHECK(sch::thread_budget().unlimited());
+  {
+    const sch::BudgetScope outer{limbs(10)};
+    {
+      const sch::BudgetScope inner{limbs(20)};
+      CHECK(sch::thread_budget().max_limbs == 20);
+    }
+    CHECK(sch::thread_budget().max_limbs == 10);
+    // other threads keep their own budget
+    std::thread{[] { CHECK(sch::thread_budget().unlimited()); }}.join();
+  }
+  CHECK(sch::thread_budget().unlimited());
+
+  sch::set_thread_budget(work(100));
+  CHECK_THROWS_AS(sch::BigInt{"1" + std::string(200, '0')} *
+                      sch::BigInt{"2" + std::string(200, '0')},
+                  sch::BudgetExceeded);
+  sch::set_thread_budget({});
+  CHECK(sch::thread_budget().unlimited());
+}
+
+TEST_CASE("budget fails fast") {
+  const sch::BigInt huge = sch::pow(sch::BigInt{7}, 2'000'000);
+  sch::Budget budget = limbs(100'000);
+  budget.max_work = 1e8;
+  const sch::BudgetScope scope{budget};
+  const auto start = std::chrono::steady_clock::now();
+  CHECK_THROWS_AS(huge * huge, sch::BudgetExceeded);
+  CHECK_THROWS_AS(sch::async::mul(huge, huge), sch::BudgetExceeded);
+  CHECK_THROWS_AS(sch::async::factorial(100'000'000), sch::BudgetExceeded);
+  const std::vector<std::pair<sch::BigInt, sch::BigInt>> tasks{
+      {sch::BigInt{2}, sch::BigInt{3}}, {huge, huge}};
+  CHECK_THROWS_AS(sch::batch::multiply(tasks), sch::BudgetExceeded);
+  CHECK_THROWS_AS(sch::dot(std::vector<sch::BigInt>{huge},
+                           std::vector<sch::BigInt>{huge}),
+                  sch::BudgetExceeded);
+  CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds{1});
+}
+
+TEST_CASE("budget cost estimates") {
+  // within a small factor of the kernels' actual leaf work
+  sch::detail::WorkEstimate exact;
+  for (const std::size_t n : {10, 32, 100, 1000, 100000}) {
+    for (const std::size_t m : {n, 3 * n + 7}) {
+      const double ratio = sch::detail::mul_cost(m, n) / exact.mul(m, n);
+      CHECK(ratio > 0.5);
+      CHECK(ratio < 2);
+    }
+    const double sqr = sch::detail::sqr_cost(n) / exact.sqr(n);
+    CHECK(sqr > 0.5);
+    CHECK(sqr < 2);
+    const double div = sch::detail::div_cost(2 * n, n) / exact.div(2 * n, n);
+    CHECK(div > 0.5);
+    CHECK(div < 2);
+  }
+}
+
+} // namespace big_int_test
@@ -0,0 +1,116 @@
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "cache.hpp"
+
+namespace big_int_test {
+
+TEST_CASE("ConstantCache values") {
+  sch::ConstantCache cache;
+  CHECK(*cache.power(10, 0) == 1);
+  CHECK(*cache.power(7, 1) == 7);
+  CHECK(*cache.power(3, 100) == sch::pow(sch::BigInt{3}, 100));
+  CHECK(*cache.power(std::uint64_t{1} << 32U, 64) ==
+        sch::pow(sch::BigInt{2}, 32 * 64));
+  CHECK(*cache.factorial(0) == 1);
+  CHECK(*cache.factorial(1) == 1);
+  CHECK(*cache.factorial(25) == sch::BigInt{"15511210043330985984000000"});
+  CHECK(*cache.primorial(1) == 1);
+  CHECK(*cache.primorial(30) == 6469693230);
+  sch::BigInt f{1};
+  for (int k = 2; k <= 500; ++k) {
+    f *= k;
+  }
+  CHECK(*cache.factorial(500) == f);
+}
+
+TEST_CASE("ConstantCache keeps values") {
+  sch::ConstantCache cache;
+  const auto p = cache.power(10, 1000);
+  CHECK(cache.power(10, 1000) == p); // the same object
+  CHECK(cache.size() == 1);
+  CHECK(cache.memory() == p->limbs().size());
+
+  // powers with exponents that are powers of two share their halves
+  static_cast<void>(cache.power(2, 64));
+  CHECK(cache.size() == 1 + 7);
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+  CHECK(cache.memory() == 0);
+  CHECK(*p == sch::pow(sch::BigInt{10}, 1000)); // still held here
+  CHECK(cache.power(10, 1000) != p);
+
+  cache.clear();
+  cache.set_memory_limit(10);
+  CHECK(cache.memory_limit() == 10);
+  const auto big = cache.factorial(1000);
+  CHECK(cache.factorial(1000) != big); // too large to keep
+  CHECK(cache.size() == 0);
+  static_cast<void>(cache.factorial(20));
+  CHECK(cache.size() == 1);
+  CHECK(cache.memory() <= 10);
+}
+
+TEST_CASE("ConstantCache from many threads") {
+  sch::ConstantCache cache;
+  std::atomic<bool> wrong{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, &wrong, t] {
+      for (std::uint64_t i = 0; i < 300; ++i) {
+        const std::uint64_t k = (i * 7 + static_cast<std::uint64_t>(t)) % 40;
+        if (*cache.power(3, k) != sch::pow(sch::BigInt{3}, k)) {
+          wrong = true;
+        }
+        if (i % 50 == 0) {
+          cache.clear();
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  CHECK(!wrong);
+}
+
+TEST_CASE("ConstantCache lookups while clear() runs back to back") {
+  sch::ConstantCache cache;
+  std::atomic<bool> wrong{false};
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) { // epochs flip twice in quick succession
+    threads.emplace_back([&cache, &done] {
+      while (!done) {
+        cache.clear();
+      }
+    });
+  }
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&cache, &wrong, t] {
+      for (std::uint64_t i = 0; i < 2000; ++i) {
+        const std::uint64_t k = (i + static_cast<std::uint64_t>(t)) % 8;
+        if (*cache.power(2, k) != sch::BigInt{1U << k}) {
+          wrong = true;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : readers) {
+    thread.join();
+  }
+  done = true;
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  CHECK(!wrong);
+}
+
+} // namespace big_int_test
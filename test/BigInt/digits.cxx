@@ -0,0 +1,125 @@
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <string>
+
+#include "BigInt.hpp"
+#include "digits.hpp"
+#include "helpers.hpp"
+#include "series.hpp"
+
+namespace big_int_test {
+
+/// @return every chunk of g, concatenated
+inline std::string drain(sch::DigitGenerator g, std::size_t *chunks = nullptr) {
+  std::string str;
+  std::size_t count = 0;
+  for (const std::string &chunk : g) {
+    str += chunk;
+    ++count;
+  }
+  if (chunks != nullptr) {
+    *chunks = count;
+  }
+  return str;
+}
+
+/// @return the first n digits of g, pulling no more chunks than needed
+inline std::string take(sch::DigitGenerator g, const std::size_t n) {
+  std::string str;
+  while (str.size() < n) {
+    str += *g.next();
+  }
+  return str.substr(0, n);
+}
+
+TEST_CASE("digits of a BigInt") {
+  for (const std::string str :
+       {"0", "7", "-7", "999999999999999999", "1000000000000000000",
+        "-1000000000000000000000000000000000000"}) {
+    CHECK(drain(sch::digits(sch::BigInt{str})) == str);
+  }
+  for (int i = 0; i < 50; ++i) {
+    std::string str = random_string(1, 3000);
+    remove_leading_zeros(str);
+    randomize_sign(str);
+    const sch::BigInt x{str};
+    CHECK(drain(sch::digits(x, 1 + i % 5)) == x.to_string());
+  }
+}
+
+TEST_CASE("product_digits") {
+  SECTION("random operands") {
+    for (int i = 0; i < 50; ++i) {
+      std::string sa = random_string(1, 4000);
+      std::string sb = random_string(1, 4000);
+      remove_leading_zeros(sa);
+      remove_leading_zeros(sb);
+      randomize_sign(sa);
+      randomize_sign(sb);
+      const sch::BigInt a{sa};
+      const sch::BigInt b{sb};
+      const std::size_t blocks = 1 + static_cast<std::size_t>(i) % 8;
+      CHECK(drain(sch::product_digits(a, b, blocks)) == (a * b).to_string());
+    }
+  }
+
+  SECTION("carries through runs of nines") {
+    const sch::BigInt nines = sch::pow(sch::BigInt{10}, 18 * 60) - 1;
+    const sch::BigInt one = sch::pow(sch::BigInt{10}, 18 * 40) + 1;
+    for (const std::size_t blocks : {1, 2, 3, 7, 40}) {
+      CHECK(drain(sch::product_digits(nines, nines, blocks)) ==
+            (nines * nines).to_string());
+      CHECK(drain(sch::product_digits(nines, one, blocks)) ==
+            (nines * one).to_string());
+      CHECK(drain(sch::product_digits(-one, nines, blocks)) ==
+            (-one * nines).to_string());
+    }
+  }
+
+  SECTION("zero") {
+    CHECK(drain(sch::product_digits(0, sch::BigInt{"-123456789"})) == "0");
+    CHECK(drain(sch::product_digits(sch::BigInt{"-123"}, 0)) == "0");
+  }
+
+  SECTION("leading digits come early") {
+    const sch::BigInt a{std::string(20000, '3')};
+    const sch::BigInt b{std::string(20000, '7')};
+    std::size_t chunks = 0;
+    CHECK(drain(sch::product_digits(a, b, 8), &chunks) == (a * b).to_string());
+    CHECK(chunks >= 4);
+  }
+}
+
+TEST_CASE("sqrt_digits") {
+  auto two = sch::sqrt_digits(2, 16);
+  CHECK(*two.next() == "1");
+  const std::string fraction = take(std::move(two), 1000);
+  const sch::BigInt scaled = sch::isqrt(2 * sch::pow(sch::BigInt{10}, 2000));
+  CHECK("1" + fraction == scaled.to_string());
+
+  auto four = sch::sqrt_digits(400);
+  CHECK(*four.next() == "20");
+  CHECK(take(std::move(four), 100) == std::string(100, '0'));
+
+  auto zero = sch::sqrt_digits(0, 1);
+  CHECK(*zero.next() == "0");
+  CHECK(*zero.next() == "0");
+
+  CHECK_THROWS_AS(sch::sqrt_digits(-1), std::invalid_argument);
+}
+
+TEST_CASE("constant streams") {
+  CHECK(take(sch::pi_digit_stream(10), 2000) == sch::pi_digits(2000));
+  CHECK(take(sch::e_digit_stream(10), 2000) == sch::e_digits(2000));
+
+  std::size_t pulled = 0;
+  for (const std::string &chunk : sch::pi_digit_stream(5)) {
+    CHECK(!chunk.empty());
+    if (++pulled == 4) {
+      break;
+    }
+  }
+  CHECK(pulled == 4);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,67 @@
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Matrix.hpp"
+#include "dot.hpp"
+#include "helpers.hpp"
+
+namespace big_int_test {
+
+TEST_CASE("fma") {
+  for (int i = 0; i < 300; ++i) {
+    const std::size_t up = i % 3 == 0 ? 3000 : 200;
+    sch::BigInt acc = i % 10 == 0 ? sch::BigInt{0} : random_big_int(1, up);
+    const sch::BigInt a = random_big_int(1, up);
+    const sch::BigInt b = random_big_int(1, up);
+    const sch::BigInt expected = acc + a * b;
+    sch::fma(acc, a, b);
+    CHECK(acc == expected);
+  }
+
+  SECTION("cancellation and aliasing") {
+    sch::BigInt acc{"-1000000000000000000000000000000000000"};
+    sch::fma(acc, sch::BigInt{"1000000000000000000"},
+             sch::BigInt{"1000000000000000000"});
+    CHECK(acc == 0);
+    CHECK(acc.sign() == sch::Sign::positive);
+
+    sch::BigInt x{"123456789012345678901234567890"};
+    const sch::BigInt x0 = x;
+    sch::fma(x, x, x);
+    CHECK(x == x0 + x0 * x0);
+    sch::fma(x, 0, x0);
+    CHECK(x == x0 + x0 * x0);
+  }
+}
+
+TEST_CASE("dot") {
+  for (const std::size_t up : {40, 400, 4000}) {
+    std::vector<sch::BigInt> a;
+    std::vector<sch::BigInt> b;
+    sch::BigInt expected{0};
+    for (int i = 0; i < 200; ++i) {
+      a.push_back(random_big_int(1, up));
+      b.push_back(random_big_int(1, up));
+      expected += a.back() * b.back();
+    }
+    CHECK(sch::dot(a, b) == expected);
+  }
+
+  // enough full-width limb products to overflow the columns many times
+  const sch::BigInt nines = sch::pow(sch::BigInt{10}, 18 * 30) - 1;
+  const std::vector<sch::BigInt> n(1000, nines);
+  CHECK(sch::dot(n, n) == 1000 * nines * nines);
+
+  const std::vector<sch::BigInt> v{3, -4};
+  CHECK(sch::dot(v, v) == 25);
+  CHECK(sch::dot(v, std::vector<sch::BigInt>{4, 3}) == 0);
+  CHECK(sch::dot(std::vector<sch::BigInt>{}, std::vector<sch::BigInt>{}) == 0);
+  CHECK_THROWS_AS(sch::dot(v, std::vector<sch::BigInt>{1}),
+                  std::invalid_argument);
+}
+
+} // namespace big_int_test
@@ -5,6 +5,9 @@
 #include <cmath>
 #include <limits>
 #include <random>
+#include <string>
+
+#include "BigInt.hpp"
 
 namespace big_int_test {
 
@@ -70,6 +73,22 @@ inline void remove_leading_zeros(std::string &str) {
   }
 }
 
+/**
+ * @param low_b digit count lower bound
+ * @param up_b digit count upper bound
+ * @param may_be_negative whether to give it a random sign
+ * @return A BigInt of L digits, such that low_b <= L <= up_b
+ */
+inline auto random_big_int(const std::size_t low_b, const std::size_t up_b,
+                           const bool may_be_negative = true) -> sch::BigInt {
+  std::string str = random_string(low_b, up_b);
+  remove_leading_zeros(str);
+  if (may_be_negative) {
+    randomize_sign(str);
+  }
+  return sch::BigInt{str};
+}
+
 /**
  * @param low_b c-string length lower bound
  * @param up_b c-string length upper bound
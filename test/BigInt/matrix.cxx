@@ -0,0 +1,156 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Matrix.hpp"
+#include "helpers.hpp"
+
+namespace big_int_test {
+
+/// @return a BigInt with between low_b and up_b digits and a random sign
+inline sch::BigInt random_signed_big_int(const std::size_t low_b,
+                                         const std::size_t up_b) {
+  std::string str = random_string(low_b, up_b);
+  remove_leading_zeros(str);
+  randomize_sign(str);
+  return sch::BigInt{str};
+}
+
+/// determinant by cofactor expansion along the first row
+sch::BigInt cofactor_det(const sch::Matrix<sch::BigInt> &m) {
+  const std::size_t n = m.rows();
+  if (n == 1) {
+    return m(0, 0);
+  }
+  sch::BigInt det = 0;
+  for (std::size_t c = 0; c < n; ++c) {
+    sch::Matrix<sch::BigInt> minor{n - 1, n - 1};
+    for (std::size_t i = 1; i < n; ++i) {
+      for (std::size_t j = 0, k = 0; j < n; ++j) {
+        if (j != c) {
+          minor(i - 1, k++) = m(i, j);
+        }
+      }
+    }
+    const sch::BigInt term = m(0, c) * cofactor_det(minor);
+    det = c % 2 == 0 ? det + term : det - term;
+  }
+  return det;
+}
+
+TEST_CASE("divexact") {
+  for (int i = 0; i < 500; ++i) {
+    const sch::BigInt a = random_signed_big_int(1, 200);
+    sch::BigInt b = random_signed_big_int(1, 120);
+    if (b == 0) {
+      b = 7;
+    }
+    CHECK(sch::divexact(a * b, b) == a);
+    CHECK(sch::divexact(a * b, a == 0 ? b : a) == (a == 0 ? 0 : b));
+  }
+  // divisors with factors of 2, 5 and whole zero limbs
+  const sch::BigInt q{"123456789123456789123456789123456789"};
+  for (const char *d : {"2", "-5", "1024", "1000000000000000000",
+                        "200000000000000000000000000000000000005",
+                        "-390625000000000000000000000000000000000000"}) {
+    CHECK(sch::divexact(q * sch::BigInt{d}, sch::BigInt{d}) == q);
+  }
+  CHECK(sch::divexact(0, 17) == 0);
+  CHECK(sch::divexact(-34, 17) == -2);
+  CHECK_THROWS_AS(sch::divexact(1, 0), std::runtime_error);
+}
+
+TEST_CASE("Matrix arithmetic") {
+  const sch::Matrix<sch::BigInt> a{{1, 2}, {3, 4}};
+  const sch::Matrix<sch::BigInt> b{{5, 6}, {7, 8}};
+  CHECK(a + b == sch::Matrix<sch::BigInt>{{6, 8}, {10, 12}});
+  CHECK(b - a == sch::Matrix<sch::BigInt>{{4, 4}, {4, 4}});
+  CHECK(a * b == sch::Matrix<sch::BigInt>{{19, 22}, {43, 50}});
+  CHECK(a * sch::Matrix<sch::BigInt>::identity(2) == a);
+  CHECK_THROWS_AS((a * sch::Matrix<sch::BigInt>{3, 1}), std::invalid_argument);
+  CHECK_THROWS_AS((sch::Matrix<sch::BigInt>{{1, 2}, {3}}),
+                  std::invalid_argument);
+}
+
+TEST_CASE("Matrix determinant") {
+  CHECK(sch::Matrix<sch::BigInt>{{1, 2}, {3, 4}}.determinant() == -2);
+  CHECK(sch::Matrix<sch::BigInt>{{0, 1}, {1, 0}}.determinant() == -1);
+  CHECK(sch::Matrix<sch::BigInt>{{1, 2}, {2, 4}}.determinant() == 0);
+  CHECK(sch::Matrix<sch::BigInt>::identity(5).determinant() == 1);
+  CHECK_THROWS_AS((sch::Matrix<sch::BigInt>{2, 3}.determinant()),
+                  std::invalid_argument);
+
+  // symmetric Pascal matrix: det of (i + j choose i) is 1
+  sch::Matrix<sch::BigInt> pascal{8, 8};
+  for (std::size_t i = 0; i < 8; ++i) {
+    for (std::size_t j = 0; j < 8; ++j) {
+      pascal(i, j) = i == 0 || j == 0 ? sch::BigInt{1}
+                                      : pascal(i - 1, j) + pascal(i, j - 1);
+    }
+  }
+  CHECK(pascal.determinant() == 1);
+
+  for (std::size_t n = 1; n <= 6; ++n) {
+    sch::Matrix<sch::BigInt> m{n, n};
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        m(i, j) = random_signed_big_int(1, 40);
+      }
+    }
+    CHECK(m.determinant() == cofactor_det(m));
+  }
+
+  // the generic template agrees on machine integers
+  CHECK(sch::Matrix<std::int64_t>{{2, 0, 1}, {1, 3, 2}, {1, 1, 2}}
+            .determinant() == 6);
+}
+
+TEST_CASE("Matrix rank") {
+  CHECK(sch::Matrix<sch::BigInt>{{1, 2, 3}, {2, 4, 6}, {1, 0, 1}}.rank() == 2);
+  CHECK(sch::Matrix<sch::BigInt>{{0, 0}, {0, 0}}.rank() == 0);
+  CHECK(sch::Matrix<sch::BigInt>{{0, 1, 2}, {0, 2, 4}}.rank() == 1);
+  CHECK(sch::Matrix<sch::BigInt>{{1, 0, 0, 1}, {0, 0, 1, 1}}.rank() == 2);
+  CHECK(sch::Matrix<sch::BigInt>::identity(7).rank() == 7);
+}
+
+TEST_CASE("Matrix solve") {
+  SECTION("small") {
+    // 2x + y = 3, x - y = 0 -> x = y = 1
+    const auto s = sch::Matrix<sch::BigInt>{{2, 1}, {1, -1}}.solve({3, 0});
+    CHECK(s.denominator == 3);
+    CHECK(s.numerators == std::vector<sch::BigInt>{3, 3});
+  }
+  SECTION("random") {
+    for (std::size_t n = 1; n <= 8; ++n) {
+      sch::Matrix<sch::BigInt> m{n, n};
+      std::vector<sch::BigInt> b(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+          m(i, j) = random_signed_big_int(1, 30);
+        }
+        b[i] = random_signed_big_int(1, 30);
+      }
+      if (m.determinant() == 0) {
+        continue;
+      }
+      const auto s = m.solve(b);
+      CHECK(s.denominator > 0);
+      // A * numerators == denominator * b
+      for (std::size_t i = 0; i < n; ++i) {
+        sch::BigInt lhs = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+          lhs += m(i, j) * s.numerators[j];
+        }
+        CHECK(lhs == s.denominator * b[i]);
+      }
+    }
+  }
+  CHECK_THROWS_AS((sch::Matrix<sch::BigInt>{{1, 2}, {2, 4}}.solve({1, 1})),
+                  std::runtime_error);
+  CHECK_THROWS_AS((sch::Matrix<sch::BigInt>{{1, 2}, {2, 4}}.solve({1})),
+                  std::invalid_argument);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,182 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "ModInt.hpp"
+#include "helpers.hpp"
+#include "limbs.hpp"
+
+namespace big_int_test {
+
+/// @return the non-negative residue of x modulo m
+inline sch::BigInt oracle_mod(const sch::BigInt &x, const sch::BigInt &m) {
+  sch::BigInt r = x % m;
+  return r < 0 ? r + m : r;
+}
+
+TEST_CASE("limb kernels") {
+  SECTION("div_base") {
+    std::mt19937_64 rng{42};
+    for (int i = 0; i < 100000; ++i) {
+      const std::uint64_t hi = rng() % sch::BigInt::BASE;
+      const __uint128_t x = static_cast<__uint128_t>(hi) << 64U | rng();
+      std::uint64_t rem = 0;
+      const std::uint64_t q = sch::detail::div_base(x, rem);
+      CHECK(q == static_cast<std::uint64_t>(x / sch::BigInt::BASE));
+      CHECK(rem == static_cast<std::uint64_t>(x % sch::BigInt::BASE));
+    }
+  }
+  SECTION("mul") {
+    for (int i = 0; i < 50; ++i) {
+      const sch::BigInt a = random_big_int(1, 400, false);
+      const sch::BigInt b = random_big_int(1, 400, false);
+      CHECK(sch::BigInt{sch::detail::mul(a.limbs(), b.limbs())} == a * b);
+    }
+  }
+}
+
+TEST_CASE("ModInt reduction choice") {
+  STATIC_REQUIRE(sch::ModInt<998244353>::REDUCTION ==
+                 sch::Reduction::montgomery);
+  STATIC_REQUIRE(sch::ModInt<1000000000000000000>::REDUCTION ==
+                 sch::Reduction::barrett);
+  STATIC_REQUIRE(sch::ModInt<std::uint64_t{1} << 61U>::REDUCTION ==
+                 sch::Reduction::special);
+}
+
+template <std::uint64_t M> void check_mod_int() {
+  using Mod = sch::ModInt<M>;
+  std::mt19937_64 rng{M};
+  for (int i = 0; i < 10000; ++i) {
+    const std::uint64_t a = rng() % M;
+    const std::uint64_t b = rng() % M;
+    const __uint128_t wa = a;
+    const __uint128_t wb = b;
+    CHECK((Mod{a} + Mod{b}).value() == (wa + wb) % M);
+    CHECK((Mod{a} - Mod{b}).value() == (wa + M - wb) % M);
+    CHECK((Mod{a} * Mod{b}).value() == wa * wb % M);
+    CHECK((-Mod{a}).value() == (M - a) % M);
+  }
+  CHECK(Mod{-1}.value() == M - 1);
+  CHECK(Mod{sch::BigInt{"-123456789012345678901234567890"}} ==
+        -Mod{sch::BigInt{"123456789012345678901234567890"}});
+  CHECK(Mod{3}.pow(0) == Mod{1});
+  CHECK(Mod{3}.pow(5) == Mod{243});
+}
+
+TEST_CASE("ModInt arithmetic") {
+  check_mod_int<998244353>();
+  check_mod_int<18446744073709551557ULL>(); // largest 64-bit prime
+  check_mod_int<1000000000000000000>();
+  check_mod_int<std::uint64_t{1} << 63U>();
+  check_mod_int<2>();
+}
+
+TEST_CASE("ModInt inverse") {
+  using Mod = sch::ModInt<998244353>;
+  for (std::uint64_t a = 1; a < 1000; ++a) {
+    CHECK(Mod{a} * Mod{a}.inv() == Mod{1});
+  }
+  CHECK_THROWS_AS(sch::ModInt<10>{4}.inv(), std::invalid_argument);
+
+  std::vector<Mod> v;
+  for (int i = 1; i <= 100; ++i) {
+    v.emplace_back(i);
+  }
+  std::vector<Mod> expected;
+  for (const auto &x : v) {
+    expected.push_back(x.inv());
+  }
+  sch::batch_inv(v.begin(), v.end());
+  CHECK(v == expected);
+}
+
+TEST_CASE("ModContext reduction choice") {
+  CHECK(sch::ModContext{"1000000"}.reduction() == sch::Reduction::special);
+  CHECK(sch::ModContext{"1" + std::string(36, '0')}.reduction() ==
+        sch::Reduction::special);
+  CHECK(sch::ModContext{"1000000007"}.reduction() ==
+        sch::Reduction::montgomery);
+  CHECK(sch::ModContext{"1000000006"}.reduction() == sch::Reduction::barrett);
+  CHECK_THROWS_AS(sch::ModContext{1}, std::invalid_argument);
+  CHECK_THROWS_AS(sch::ModContext{-7}, std::invalid_argument);
+}
+
+TEST_CASE("ModContext arithmetic") {
+  std::vector<sch::BigInt> moduli;
+  for (int i = 0; i < 10; ++i) {
+    moduli.push_back(random_big_int(2, 120, false) + 2);
+  }
+  moduli.emplace_back("1" + std::string(40, '0'));
+  moduli.emplace_back("1" + std::string(54, '0'));
+  moduli.emplace_back("170141183460469231731687303715884105727");
+  moduli.emplace_back(std::string(36, '9') + "5");
+  // full Barrett products
+  moduli.push_back(random_big_int(2400, 2600, false) + 2);
+
+  for (const auto &m : moduli) {
+    const sch::ModContext ctx{m};
+    for (int i = 0; i < 20; ++i) {
+      const sch::BigInt x = random_big_int(1, i % 4 == 0 ? 3000 : 300);
+      const std::size_t ab_digits = i % 4 == 0 ? 3000 : 150;
+      const sch::BigInt a = oracle_mod(random_big_int(1, ab_digits), m);
+      const sch::BigInt b = oracle_mod(random_big_int(1, ab_digits), m);
+      CHECK(ctx.reduce(x) == oracle_mod(x, m));
+      CHECK(ctx.reduce(-x) == oracle_mod(-x, m));
+      CHECK(ctx.add(a, b) == oracle_mod(a + b, m));
+      CHECK(ctx.sub(a, b) == oracle_mod(a - b, m));
+      CHECK(ctx.mul(a, b) == oracle_mod(a * b, m));
+    }
+  }
+}
+
+TEST_CASE("ModContext pow") {
+  for (const char *m : {"1000000007", "1000000006", "1000000000000",
+                        "987654321987654321987654321987654321"}) {
+    const sch::ModContext ctx{m};
+    const sch::BigInt base = random_big_int(1, 60, false);
+    sch::BigInt expected = 1;
+    for (int e = 0; e < 40; ++e) {
+      CHECK(ctx.pow(base, e) == expected);
+      expected = oracle_mod(expected * base, ctx.modulus());
+    }
+    CHECK_THROWS_AS(ctx.pow(base, -1), std::invalid_argument);
+  }
+  // Fermat: a^(p-1) == 1 mod p
+  const sch::BigInt p{"170141183460469231731687303715884105727"};
+  const sch::ModContext ctx{p};
+  CHECK(ctx.pow(sch::BigInt{"123456789123456789123456789"}, p - 1) == 1);
+}
+
+TEST_CASE("ModContext batch") {
+  const sch::BigInt m{"340282366920938463463374607431768211297"};
+  const sch::ModContext ctx{m};
+  std::vector<sch::BigInt> a;
+  std::vector<sch::BigInt> b;
+  for (int i = 0; i < 50; ++i) {
+    a.push_back(oracle_mod(random_big_int(1, 80), m));
+    b.push_back(oracle_mod(random_big_int(1, 80), m));
+  }
+  std::vector<sch::BigInt> out(a.size());
+
+  ctx.mul(a.begin(), a.end(), b.begin(), out.begin());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    CHECK(out[i] == ctx.mul(a[i], b[i]));
+  }
+  ctx.add(a.begin(), a.end(), b.begin(), out.begin());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    CHECK(out[i] == ctx.add(a[i], b[i]));
+  }
+  ctx.sub(a.begin(), a.end(), b.begin(), out.begin());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    CHECK(out[i] == ctx.sub(a[i], b[i]));
+  }
+  ctx.pow(a.begin(), a.end(), sch::BigInt{65537}, out.begin());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    CHECK(out[i] == ctx.pow(a[i], 65537));
+  }
+}
+
+} // namespace big_int_test
@@ -0,0 +1,97 @@
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include "BigInt.hpp"
+#include "helpers.hpp"
+#include "outofcore.hpp"
+
+namespace big_int_test {
+
+/// a fresh directory for the test's files, removed at the end
+struct TempDir {
+  TempDir()
+      : path{std::filesystem::temp_directory_path() /
+             ("sch-" + std::to_string(random_in_range(0, 1U << 30)))} {
+    std::filesystem::create_directories(path);
+  }
+  ~TempDir() { std::filesystem::remove_all(path); }
+  TempDir(const TempDir &) = delete;
+  TempDir &operator=(const TempDir &) = delete;
+
+  [[nodiscard]] std::string file(const std::string &name) const {
+    return (path / name).string();
+  }
+
+  std::filesystem::path path;
+};
+
+TEST_CASE("LimbFile") {
+  const TempDir dir;
+  const sch::BigInt x{"-123456789012345678901234567890"};
+  {
+    const sch::LimbFile file = sch::LimbFile::write(dir.file("x"), x);
+    CHECK(file.size() == x.limbs().size());
+    CHECK(file.to_bigint() == -x);
+  }
+  const sch::LimbFile reopened = sch::LimbFile::open(dir.file("x"));
+  CHECK(reopened.to_bigint() == -x);
+
+  const sch::LimbFile zeros = sch::LimbFile::create(dir.file("z"), 5);
+  CHECK(zeros.size() == 5);
+  CHECK(zeros.significant() == 1);
+  CHECK(zeros.to_bigint() == 0);
+
+  CHECK_THROWS_AS(sch::LimbFile::open(dir.file("missing")), std::system_error);
+  CHECK_THROWS_AS(sch::LimbFile::temporary(dir.file("missing"), 1),
+                  std::system_error);
+  // a scratch file has no name even while it is open
+  const sch::LimbFile t = sch::LimbFile::temporary(dir.path.string(), 10);
+  CHECK(t.size() == 10);
+  std::size_t files = 0;
+  for ([[maybe_unused]] const auto &entry :
+       std::filesystem::directory_iterator{dir.path}) {
+    ++files;
+  }
+  CHECK(files == 2);
+}
+
+TEST_CASE("mul_out_of_core") {
+  const TempDir dir;
+  sch::OutOfCoreOptions options;
+  options.directory = dir.path.string();
+  options.memory_limbs = 64; // everything above 64 limbs goes through files
+
+  SECTION("BigInt operands") {
+    for (int i = 0; i < 20; ++i) {
+      const sch::BigInt a = random_big_int(1, 30000);
+      const sch::BigInt b = random_big_int(1, 30000);
+      CHECK(sch::mul_out_of_core(a, b, options) == a * b);
+    }
+    const sch::BigInt nines = sch::pow(sch::BigInt{10}, 18 * 500) - 1;
+    CHECK(sch::mul_out_of_core(nines, nines, options) == nines * nines);
+    CHECK(sch::mul_out_of_core(nines, 0, options) == 0);
+  }
+
+  SECTION("file operands") {
+    const sch::BigInt a = random_big_int(20000, 20000);
+    const sch::BigInt b = random_big_int(7000, 7000);
+    const sch::LimbFile fa = sch::LimbFile::write(dir.file("a"), a);
+    const sch::LimbFile fb = sch::LimbFile::write(dir.file("b"), b);
+    sch::LimbFile fr =
+        sch::LimbFile::create(dir.file("r"), fa.size() + fb.size() + 3);
+    sch::mul_out_of_core(fa, fb, fr, options);
+    sch::BigInt expected = a * b;
+    if (expected < 0) {
+      expected = -expected;
+    }
+    CHECK(fr.to_bigint() == expected);
+
+    sch::LimbFile small = sch::LimbFile::create(dir.file("s"), fa.size());
+    CHECK_THROWS_AS(sch::mul_out_of_core(fa, fb, small, options),
+                    std::invalid_argument);
+  }
+}
+
+} // namespace big_int_test
@@ -0,0 +1,253 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Matrix.hpp"
+#include "parallel.hpp"
+#include "recurrence.hpp"
+#include "series.hpp"
+
+namespace big_int_test {
+
+/// runs every task inline, counting them
+class InlineExecutor final : public sch::Executor {
+public:
+  void submit(std::function<void()> task) override {
+    ++submitted;
+    task();
+  }
+  [[nodiscard]] unsigned concurrency() const override { return 4; }
+  std::atomic<std::size_t> submitted{0};
+};
+
+/// queues every task and never runs any: only waiting callers make progress
+class StalledExecutor final : public sch::Executor {
+public:
+  void submit(std::function<void()> task) override {
+    tasks.push_back(std::move(task));
+  }
+  [[nodiscard]] unsigned concurrency() const override { return 8; }
+  std::vector<std::function<void()>> tasks;
+};
+
+/// restores the default executor when the test ends, even on failure
+struct ExecutorGuard {
+  ExecutorGuard() = default;
+  ~ExecutorGuard() { sch::set_executor(nullptr); }
+  ExecutorGuard(const ExecutorGuard &) = delete;
+  ExecutorGuard &operator=(const ExecutorGuard &) = delete;
+};
+
+/// counts the bodies running at once, keeping the most seen
+class ConcurrencyMeter {
+public:
+  void enter() {
+    const int now = ++_active;
+    for (int seen = most.load(); now > seen && !most.compare_exchange_weak(
+                                                   seen, now);) {
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    --_active;
+  }
+  std::atomic<int> most{0};
+
+private:
+  std::atomic<int> _active{0};
+};
+
+void check_covers_every_index(const sch::ExecutionPolicy policy) {
+  for (const std::size_t n : {0, 1, 2, 7, 1000}) {
+    std::vector<std::atomic<int>> hits(n);
+    sch::parallel_for(0, n, [&](const std::size_t i) { ++hits[i]; }, policy);
+    for (std::size_t i = 0; i < n; ++i) {
+      REQUIRE(hits[i] == 1);
+    }
+  }
+}
+
+TEST_CASE("set_num_threads") {
+  const ExecutorGuard guard;
+  sch::set_num_threads(3);
+  CHECK(sch::num_threads() == 3);
+  CHECK(sch::par.concurrency() == 3);
+  CHECK(sch::seq.concurrency() == 1);
+  CHECK(sch::ExecutionPolicy::threads(2).concurrency() == 2);
+  CHECK(sch::ExecutionPolicy::threads(5).concurrency() == 3);
+  sch::set_num_threads(1);
+  CHECK(sch::num_threads() == 1);
+  sch::set_num_threads(0);
+  CHECK(sch::num_threads() >= 1);
+}
+
+TEST_CASE("parallel_for") {
+  const ExecutorGuard guard;
+  for (const unsigned threads : {1U, 2U, 4U}) {
+    sch::set_num_threads(threads);
+    check_covers_every_index(sch::par);
+    check_covers_every_index(sch::seq);
+    check_covers_every_index(sch::ExecutionPolicy::threads(2));
+  }
+}
+
+TEST_CASE("nested parallel_for") {
+  const ExecutorGuard guard;
+  for (const unsigned threads : {1U, 2U, 4U}) {
+    sch::set_num_threads(threads);
+    std::atomic<std::size_t> sum{0};
+    sch::parallel_for(0, 16, [&](const std::size_t i) {
+      sch::parallel_for(0, 16, [&](const std::size_t j) { sum += i * j; });
+    });
+    CHECK(sum == 120 * 120);
+  }
+}
+
+TEST_CASE("a policy caps the threads of everything the call forks") {
+  const ExecutorGuard guard;
+  sch::set_num_threads(8);
+  const auto two = sch::ExecutionPolicy::threads(2);
+
+  SECTION("parallel_for") {
+    ConcurrencyMeter meter;
+    sch::parallel_for(0, 64, [&](std::size_t) { meter.enter(); }, two);
+    CHECK(meter.most <= 2);
+  }
+
+  SECTION("nested parallel_for") {
+    ConcurrencyMeter meter;
+    std::atomic<int> count{0};
+    sch::parallel_for(
+        0, 8,
+        [&](std::size_t) {
+          sch::parallel_for(0, 8, [&](std::size_t) {
+            meter.enter();
+            ++count;
+          });
+        },
+        two);
+    CHECK(count == 64);
+    CHECK(meter.most <= 2);
+  }
+
+  SECTION("TaskGroup") {
+    ConcurrencyMeter meter;
+    std::atomic<int> count{0};
+    sch::TaskGroup group{two};
+    for (int i = 0; i < 32; ++i) {
+      group.run([&] {
+        meter.enter();
+        ++count;
+      });
+    }
+    group.wait();
+    CHECK(count == 32);
+    CHECK(meter.most <= 2);
+  }
+
+  SECTION("seq") {
+    ConcurrencyMeter meter;
+    sch::parallel_for(0, 16, [&](std::size_t) { meter.enter(); }, sch::seq);
+    CHECK(meter.most == 1);
+  }
+}
+
+TEST_CASE("TaskGroup") {
+  const ExecutorGuard guard;
+  sch::set_num_threads(4);
+
+  SECTION("runs every task") {
+    std::atomic<int> count{0};
+    sch::TaskGroup group;
+    for (int i = 0; i < 100; ++i) {
+      group.run([&] { ++count; });
+    }
+    group.wait();
+    CHECK(count == 100);
+  }
+
+  SECTION("rethrows an exception") {
+    std::atomic<int> count{0};
+    sch::TaskGroup group;
+    for (int i = 0; i < 10; ++i) {
+      group.run([&, i] {
+        ++count;
+        if (i == 3) {
+          throw std::runtime_error("task 3");
+        }
+      });
+    }
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    CHECK(count == 10);
+    CHECK_NOTHROW(group.wait());
+  }
+
+  SECTION("parallel_for rethrows") {
+    CHECK_THROWS_AS(sch::parallel_for(0, 100,
+                                      [](const std::size_t i) {
+                                        if (i == 57) {
+                                          throw std::out_of_range("57");
+                                        }
+                                      }),
+                    std::out_of_range);
+  }
+}
+
+TEST_CASE("set_executor") {
+  const ExecutorGuard guard;
+
+  SECTION("a custom executor runs the tasks") {
+    const auto inline_executor = std::make_shared<InlineExecutor>();
+    sch::set_executor(inline_executor);
+    CHECK(sch::num_threads() == 4);
+    check_covers_every_index(sch::par);
+    CHECK(inline_executor->submitted > 0);
+    CHECK(sch::pi_digits(200) == sch::pi_digits(200, sch::seq));
+  }
+
+  SECTION("callers make progress on an executor that never runs tasks") {
+    const auto stalled = std::make_shared<StalledExecutor>();
+    sch::set_executor(stalled);
+    std::atomic<std::size_t> sum{0};
+    sch::parallel_for(0, 100, [&](const std::size_t i) { sum += i; });
+    CHECK(sum == 4950);
+    CHECK(!stalled->tasks.empty());
+    for (auto &task : stalled->tasks) { // already run: these do nothing
+      task();
+    }
+    CHECK(sum == 4950);
+  }
+
+  SECTION("nullptr restores the default pool") {
+    sch::set_executor(std::make_shared<InlineExecutor>());
+    sch::set_executor(nullptr);
+    CHECK(dynamic_cast<sch::ThreadPool *>(sch::executor().get()) != nullptr);
+  }
+}
+
+TEST_CASE("policies agree") {
+  const ExecutorGuard guard;
+  sch::set_num_threads(4);
+
+  sch::Matrix<sch::BigInt> a{12, 12};
+  for (std::size_t i = 0; i < 12; ++i) {
+    for (std::size_t j = 0; j < 12; ++j) {
+      a(i, j) = sch::BigInt{static_cast<int>((i * 7 + j * j * 3) % 23) - 11};
+    }
+  }
+  CHECK(a.determinant(sch::par) == a.determinant(sch::seq));
+  CHECK(a.rank(sch::par) == a.rank(sch::seq));
+
+  const std::vector<sch::BigInt> c{1, 2, 3, 4};
+  const std::vector<sch::BigInt> init{1, 1, 1, 1};
+  CHECK(sch::linear_recurrence(c, init, 5000, sch::par) ==
+        sch::linear_recurrence(c, init, 5000, sch::seq));
+  CHECK(sch::e_digits(1000, sch::ExecutionPolicy::threads(2)) ==
+        sch::e_digits(1000, sch::seq));
+}
+
+} // namespace big_int_test
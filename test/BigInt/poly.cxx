@@ -0,0 +1,138 @@
+#include <catch2/catch_all.hpp>
+#include <sstream>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Poly.hpp"
+#include "helpers.hpp"
+
+namespace big_int_test {
+
+/// @return a BigInt with between low_b and up_b digits and a random sign
+inline sch::BigInt random_signed_big_int(const std::size_t low_b,
+                                         const std::size_t up_b) {
+  std::string str = random_string(low_b, up_b);
+  remove_leading_zeros(str);
+  randomize_sign(str);
+  return sch::BigInt{str};
+}
+
+inline sch::Poly random_poly(const std::size_t terms,
+                             const std::size_t digits) {
+  std::vector<sch::BigInt> coeffs;
+  for (std::size_t i = 0; i < terms; ++i) {
+    coeffs.push_back(random_signed_big_int(1, digits));
+  }
+  return sch::Poly{coeffs};
+}
+
+/// school-book product, the oracle for Kronecker substitution
+inline sch::Poly naive_mul(const sch::Poly &a, const sch::Poly &b) {
+  if (a.is_zero() || b.is_zero()) {
+    return sch::Poly{};
+  }
+  std::vector<sch::BigInt> c(a.coeffs().size() + b.coeffs().size() - 1, 0);
+  for (std::size_t i = 0; i < a.coeffs().size(); ++i) {
+    for (std::size_t j = 0; j < b.coeffs().size(); ++j) {
+      c[i + j] += a.coeffs()[i] * b.coeffs()[j];
+    }
+  }
+  return sch::Poly{c};
+}
+
+TEST_CASE("limb Karatsuba") {
+  for (int i = 0; i < 100; ++i) {
+    const sch::BigInt a = random_signed_big_int(1, 3000);
+    const sch::BigInt b = random_signed_big_int(1, 3000);
+    const sch::BigInt p = a * b;
+    CHECK(p == b * a);
+    if (b != 0) {
+      CHECK(p / b == a);
+    }
+  }
+  CHECK(-sch::BigInt{0} == sch::BigInt{0});
+  CHECK((-sch::BigInt{0}).sign() == sch::Sign::positive);
+}
+
+TEST_CASE("Poly basics") {
+  const sch::Poly p{1, 2, 3}; // 3x^2 + 2x + 1
+  CHECK(p.degree() == 2);
+  CHECK(sch::Poly{}.degree() == -1);
+  CHECK(sch::Poly{0, 0}.is_zero());
+  CHECK(p[1] == 2);
+  CHECK(p[7] == 0);
+  CHECK(p + sch::Poly{-1, -2, -3} == sch::Poly{});
+  CHECK(p - sch::Poly{1} == sch::Poly{0, 2, 3});
+  CHECK(p.derivative() == sch::Poly{2, 6});
+  CHECK(p(10) == 321);
+  CHECK(p(-1) == 2);
+
+  std::ostringstream os;
+  os << sch::Poly{-1, 0, 1, -2};
+  CHECK(os.str() == "-2x^3 + x^2 - 1");
+}
+
+TEST_CASE("Poly multiplication") {
+  CHECK(sch::Poly{1, 1} * sch::Poly{-1, 1} == sch::Poly{-1, 0, 1});
+  CHECK(sch::Poly{1, 2} * sch::Poly{} == sch::Poly{});
+  // a product coefficient of exactly zero between large ones
+  const sch::BigInt e18{"1000000000000000000"};
+  CHECK(sch::Poly{e18, 1} * sch::Poly{-1, e18} ==
+        (sch::Poly{-e18, e18 * e18 - 1, e18}));
+  for (int i = 0; i < 40; ++i) {
+    const sch::Poly a = random_poly(1 + i % 17, 1 + 5 * i);
+    const sch::Poly b = random_poly(1 + i % 11, 1 + 3 * i);
+    CHECK(a * b == naive_mul(a, b));
+  }
+}
+
+TEST_CASE("Poly division") {
+  const sch::Poly a = random_poly(20, 30);
+  const sch::Poly d = sch::Poly{3, -5, 7} * sch::Poly{0, 0, 0, 0, 1} +
+                      sch::Poly{0, 0, 0, 0, 0, 0, 0, -1};
+  const auto [q, r] = a.divmod(d);
+  CHECK(q * d + r == a);
+  CHECK(r.degree() < d.degree());
+  CHECK(a * d / d == a);
+  CHECK_THROWS_AS(a.divmod(sch::Poly{1, 2}), std::invalid_argument);
+  CHECK_THROWS_AS(a.divmod(sch::Poly{}), std::invalid_argument);
+}
+
+TEST_CASE("Poly multipoint evaluation") {
+  const sch::Poly p = random_poly(40, 25);
+  std::vector<sch::BigInt> xs;
+  for (int i = 0; i < 37; ++i) {
+    xs.push_back(random_signed_big_int(1, 10));
+  }
+  std::vector<sch::BigInt> values(xs.size());
+  p.evaluate(xs.begin(), xs.end(), values.begin());
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    CHECK(values[i] == p(xs[i]));
+  }
+}
+
+TEST_CASE("Poly interpolation") {
+  SECTION("integral") {
+    const sch::Poly p = random_poly(25, 20);
+    std::vector<sch::BigInt> xs;
+    for (int i = -12; i <= 12; ++i) {
+      xs.emplace_back(3 * i + 1);
+    }
+    std::vector<sch::BigInt> ys(xs.size());
+    p.evaluate(xs.begin(), xs.end(), ys.begin());
+    const auto interpolant = sch::Poly::interpolate(xs, ys);
+    CHECK(interpolant.denominator == 1);
+    CHECK(interpolant.numerator == p);
+  }
+  SECTION("rational") {
+    // through (0, 0), (2, 1): x / 2
+    const auto half = sch::Poly::interpolate({0, 2}, {0, 1});
+    CHECK(half.numerator == sch::Poly{0, 1});
+    CHECK(half.denominator == 2);
+  }
+  CHECK_THROWS_AS(sch::Poly::interpolate({1, 1}, {2, 3}),
+                  std::invalid_argument);
+  CHECK_THROWS_AS(sch::Poly::interpolate({1, 2}, {2}), std::invalid_argument);
+}
+
+} // namespace big_int_test
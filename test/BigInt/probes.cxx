@@ -0,0 +1,55 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BigInt.hpp"
+
+namespace big_int_test {
+
+/// @return the arguments of the entry and return probes of `name`, in order
+inline std::vector<std::pair<std::uint64_t, std::uint64_t>>
+probe_args(const std::string &name) {
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> args;
+  for (const FiredProbe &p : fired_probes) {
+    if (p.name == name + "_entry" || p.name == name + "_return") {
+      args.emplace_back(p.arg1, p.arg2);
+    }
+  }
+  fired_probes.clear();
+  return args;
+}
+
+TEST_CASE("probes are placed for this target") {
+  STATIC_REQUIRE(SCH_HAVE_USDT == 1);
+}
+
+TEST_CASE("from_string probes report the limbs the digits fill") {
+  fired_probes.clear();
+  for (const std::size_t digits : {1, 17, 18, 19, 36, 37}) {
+    for (const bool negative : {false, true}) {
+      const std::string str =
+          (negative ? "-" : "") + std::string(digits, '9');
+      const sch::BigInt x{str};
+      const std::uint64_t limbs = x.limbs().size();
+      CHECK(limbs == (digits + 17) / 18);
+      const auto args = probe_args("from_string");
+      REQUIRE(args.size() == 2);
+      CHECK(args[0] == std::pair{limbs, std::uint64_t{str.size()}});
+      CHECK(args[1] == args[0]);
+    }
+  }
+}
+
+TEST_CASE("multiplication probes report the operand limbs") {
+  const sch::BigInt a{std::string(40, '7')};
+  const sch::BigInt b{"-" + std::string(18, '3')};
+  fired_probes.clear();
+  const sch::BigInt p = a * b;
+  const auto args = probe_args("mul");
+  REQUIRE(args.size() == 2);
+  CHECK(args[0] == std::pair{std::uint64_t{3}, std::uint64_t{1}});
+}
+
+} // namespace big_int_test
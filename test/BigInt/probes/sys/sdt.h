@@ -0,0 +1,28 @@
+#ifndef SCH_TEST_BIGINT_PROBES_SYS_SDT_H_
+#define SCH_TEST_BIGINT_PROBES_SYS_SDT_H_
+
+// stands in for the system <sys/sdt.h>: a probe records its name and
+// arguments instead of placing a nop, so that a test can check them
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace big_int_test {
+
+struct FiredProbe {
+  std::string name;
+  std::uint64_t arg1;
+  std::uint64_t arg2;
+};
+
+inline std::vector<FiredProbe> fired_probes;
+
+} // namespace big_int_test
+
+#define DTRACE_PROBE2(provider, name, arg1, arg2)                              \
+  ::big_int_test::fired_probes.push_back(                                      \
+      {#name, static_cast<std::uint64_t>(arg1),                                \
+       static_cast<std::uint64_t>(arg2)})
+
+#endif // SCH_TEST_BIGINT_PROBES_SYS_SDT_H_
@@ -0,0 +1,91 @@
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+
+#include "BigInt.hpp"
+#include "random.hpp"
+
+namespace big_int_test {
+
+TEST_CASE("random_digits") {
+  std::mt19937_64 rng{1};
+  for (std::size_t n = 1; n <= 100; ++n) {
+    const sch::BigInt x = sch::random_digits(n, rng);
+    CHECK(x.to_string().size() == n);
+  }
+  CHECK(sch::random_digits(0, rng) == 0);
+  CHECK(sch::random_digits(100000).to_string().size() == 100000);
+
+  // the same seed, the same numbers
+  std::mt19937_64 a{42};
+  std::mt19937_64 b{42};
+  CHECK(sch::random_digits(500, a) == sch::random_digits(500, b));
+
+  // every leading digit, about equally often
+  std::array<int, 10> leading{};
+  for (int i = 0; i < 9000; ++i) {
+    ++leading[static_cast<std::size_t>(
+        sch::random_digits(37, rng).to_string().front() - '0')];
+  }
+  CHECK(leading[0] == 0);
+  for (std::size_t d = 1; d < 10; ++d) {
+    CHECK(leading[d] > 850);
+    CHECK(leading[d] < 1150);
+  }
+}
+
+TEST_CASE("random_below") {
+  std::mt19937 rng{7}; // a 32-bit generator works too
+  std::array<int, 7> counts{};
+  for (int i = 0; i < 7000; ++i) {
+    const sch::BigInt x = sch::random_below(7, rng);
+    REQUIRE(x >= 0);
+    REQUIRE(x < 7);
+    ++counts[static_cast<std::size_t>(std::stoi(x.to_string()))];
+  }
+  for (const int c : counts) {
+    CHECK(c > 850);
+    CHECK(c < 1150);
+  }
+
+  // a bound whose top limb is small: the lower limbs still range freely
+  const sch::BigInt bound =
+      3 * sch::pow(sch::BigInt{10}, 36) + sch::BigInt{"123456789"};
+  std::array<int, 3> tops{};
+  for (int i = 0; i < 3000; ++i) {
+    const sch::BigInt x = sch::random_below(bound, rng);
+    REQUIRE(x >= 0);
+    REQUIRE(x < bound);
+    const std::size_t top =
+        x.limbs().size() == 3 ? static_cast<std::size_t>(x.limbs()[2]) : 0;
+    REQUIRE(top < 3);
+    ++tops[top];
+  }
+  for (const int c : tops) {
+    CHECK(c > 850);
+    CHECK(c < 1150);
+  }
+
+  CHECK(sch::random_below(1) == 0);
+  CHECK_THROWS_AS(sch::random_below(0), std::invalid_argument);
+  CHECK_THROWS_AS(sch::random_below(-5), std::invalid_argument);
+}
+
+TEST_CASE("random_bits") {
+  std::mt19937_64 rng{3};
+  const sch::BigInt limit = sch::pow(sch::BigInt{2}, 200);
+  bool high = false; // the top bit is set sometimes
+  for (int i = 0; i < 200; ++i) {
+    const sch::BigInt x = sch::random_bits(200, rng);
+    REQUIRE(x >= 0);
+    REQUIRE(x < limit);
+    high = high || x >= limit / 2;
+  }
+  CHECK(high);
+  CHECK(sch::random_bits(0, rng) == 0);
+  CHECK(sch::random_bits(1) < 2);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,62 @@
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "recurrence.hpp"
+
+namespace big_int_test {
+
+/// the oracle: step the recurrence n times
+inline sch::BigInt iterate(const std::vector<sch::BigInt> &coeffs,
+                           std::vector<sch::BigInt> terms,
+                           const std::size_t n) {
+  while (terms.size() <= n) {
+    sch::BigInt next = 0;
+    for (std::size_t i = 0; i < coeffs.size(); ++i) {
+      next += coeffs[i] * terms[terms.size() - 1 - i];
+    }
+    terms.push_back(next);
+  }
+  return terms[n];
+}
+
+TEST_CASE("squaring") {
+  for (const std::size_t digits : {1, 17, 19, 300, 1000, 5000}) {
+    const sch::BigInt a{std::string(digits, '9')};
+    const sch::BigInt b{a};
+    CHECK(a * a == a * (b + 1) - a);
+    CHECK(a * -b == -(a * a));
+  }
+}
+
+TEST_CASE("linear_recurrence") {
+  SECTION("Fibonacci") {
+    const std::vector<sch::BigInt> c{1, 1};
+    const std::vector<sch::BigInt> init{0, 1};
+    CHECK(sch::linear_recurrence(c, init, 0) == 0);
+    CHECK(sch::linear_recurrence(c, init, 1) == 1);
+    CHECK(sch::linear_recurrence(c, init, 10) == 55);
+    CHECK(sch::linear_recurrence(c, init, 100) ==
+          sch::BigInt{"354224848179261915075"});
+    CHECK(sch::linear_recurrence(c, init, 5000) == iterate(c, init, 5000));
+  }
+  SECTION("signed coefficients") {
+    // a_k = 3 a_{k-1} - 5 a_{k-2} + 7 a_{k-4}
+    const std::vector<sch::BigInt> c{3, -5, 0, 7};
+    const std::vector<sch::BigInt> init{2, -1, 4, 10};
+    for (const std::size_t n : {4, 5, 63, 64, 65, 777}) {
+      CHECK(sch::linear_recurrence(c, init, n) == iterate(c, init, n));
+    }
+  }
+  SECTION("first order") {
+    CHECK(sch::linear_recurrence({2}, {3}, 200) ==
+          3 * sch::pow(sch::BigInt{2}, 200));
+  }
+  CHECK_THROWS_AS(sch::linear_recurrence({}, {}, 3), std::invalid_argument);
+  CHECK_THROWS_AS(sch::linear_recurrence({1, 1}, {0}, 3),
+                  std::invalid_argument);
+  CHECK_THROWS_AS(sch::linear_recurrence({1, 1}, {0, 1}, -1),
+                  std::invalid_argument);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,78 @@
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <string>
+
+#include "BigInt.hpp"
+#include "ScaledInt.hpp"
+#include "helpers.hpp"
+
+namespace big_int_test {
+
+/// @return a random value with a random run of trailing zeros, often none
+inline sch::BigInt random_scaled_value() {
+  std::string str = random_string(1, 200);
+  remove_leading_zeros(str);
+  if (random_in_range(0, 2) != 0) {
+    str.append(random_in_range(0, 100), '0');
+  }
+  randomize_sign(str);
+  return sch::BigInt{str};
+}
+
+TEST_CASE("ScaledInt representation") {
+  const sch::ScaledInt x{sch::BigInt{"-5000000000000000000000000000000000000"}};
+  CHECK(x.mantissa() == -5);
+  CHECK(x.exponent() == 2);
+  CHECK(x.to_bigint() == sch::BigInt{"-5000000000000000000000000000000000000"});
+  CHECK(x.to_string() == "-5000000000000000000000000000000000000");
+
+  const sch::ScaledInt zero{0, 7};
+  CHECK(zero.is_zero());
+  CHECK(zero.exponent() == 0);
+  CHECK(zero == sch::ScaledInt{});
+  CHECK(zero.to_string() == "0");
+
+  const sch::ScaledInt p = sch::ScaledInt::pow10(1000000);
+  CHECK(p.exponent() == 1000000 / 18);
+  CHECK(p.mantissa() == 10000000000);
+  CHECK(sch::ScaledInt::pow10(40).to_bigint() == sch::pow(sch::BigInt{10}, 40));
+
+  sch::ScaledInt y{123};
+  y.mul_pow10(36);
+  CHECK(y.exponent() == 2);
+  CHECK(y.mantissa() == 123);
+  y.mul_pow10(17);
+  CHECK(y.to_bigint() == 123 * sch::pow(sch::BigInt{10}, 53));
+  CHECK(y.scale(3).to_bigint() == 123 * sch::pow(sch::BigInt{10}, 107));
+  sch::ScaledInt fifty{50};
+  CHECK(fifty.mul_pow10(17).exponent() == 1); // 5 * 10^18
+  CHECK(fifty.mantissa() == 5);
+}
+
+TEST_CASE("ScaledInt arithmetic") {
+  for (int i = 0; i < 300; ++i) {
+    const sch::BigInt a = random_scaled_value();
+    const sch::BigInt b = random_scaled_value();
+    const sch::ScaledInt x{a};
+    const sch::ScaledInt y{b};
+    CHECK((x + y).to_bigint() == a + b);
+    CHECK((x - y).to_bigint() == a - b);
+    CHECK((x * y).to_bigint() == a * b);
+    CHECK((x < y) == (a < b));
+    CHECK((x <= y) == (a <= b));
+    CHECK((x == y) == (a == b));
+    CHECK((x - x).is_zero());
+    CHECK(x.to_string() == a.to_string());
+  }
+  // cancellation leaves trailing zero limbs to fold into the exponent
+  const sch::ScaledInt a{sch::BigInt{"1000000000000000001000000000000000000"}};
+  const sch::ScaledInt b{sch::BigInt{"1000000000000000000"}};
+  CHECK((a - b).mantissa() == 1);
+  CHECK((a - b).exponent() == 2);
+  CHECK(sch::ScaledInt{-3} < sch::ScaledInt{-2});
+  CHECK(sch::ScaledInt{-1, 5} < sch::ScaledInt{0});
+  CHECK(sch::ScaledInt{1, 5} > sch::ScaledInt{sch::BigInt{"999999999999999999"},
+                                              4});
+}
+
+} // namespace big_int_test
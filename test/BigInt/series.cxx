@@ -0,0 +1,66 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+
+#include "BigInt.hpp"
+#include "series.hpp"
+
+namespace big_int_test {
+
+TEST_CASE("isqrt") {
+  CHECK(sch::isqrt(0) == 0);
+  CHECK(sch::isqrt(1) == 1);
+  CHECK(sch::isqrt(99) == 9);
+  CHECK(sch::isqrt(100) == 10);
+  for (int i = 1; i < 60; ++i) {
+    const sch::BigInt r = sch::pow(sch::BigInt{7}, 5 * i) + i;
+    CHECK(sch::isqrt(r * r) == r);
+    CHECK(sch::isqrt(r * r - 1) == r - 1);
+    CHECK(sch::isqrt(r * r + 2 * r) == r);
+  }
+  CHECK_THROWS_AS(sch::isqrt(-4), std::invalid_argument);
+}
+
+TEST_CASE("binary_split") {
+  const auto one = [](std::size_t) { return 1; };
+  SECTION("constant terms") {
+    const auto s = sch::binary_split(0, 1000, one, one, one);
+    CHECK(s.P == 1);
+    CHECK(s.Q == 1);
+    CHECK(s.T == 1000);
+  }
+  SECTION("geometric series") {
+    // sum_{k=0}^{n-1} 2^-k = (2^n - 1) / 2^(n-1)
+    const auto two = [](const std::size_t k) { return k == 0 ? 1 : 2; };
+    const auto s = sch::binary_split(0, 700, one, two, one);
+    CHECK(s.Q == sch::pow(sch::BigInt{2}, 699));
+    CHECK(s.T == sch::pow(sch::BigInt{2}, 700) - 1);
+  }
+  SECTION("factorial") {
+    const auto k = [](const std::size_t i) { return i; };
+    const auto s = sch::binary_split(1, 301, k, one, one);
+    sch::BigInt factorial = 1;
+    for (int i = 1; i <= 300; ++i) {
+      factorial *= i;
+    }
+    CHECK(s.P == factorial);
+  }
+  CHECK_THROWS_AS(sch::binary_split(5, 5, one, one, one),
+                  std::invalid_argument);
+}
+
+TEST_CASE("pi_digits and e_digits") {
+  CHECK(sch::pi_digits(1) == "3");
+  CHECK(sch::pi_digits(50) ==
+        "31415926535897932384626433832795028841971693993751");
+  CHECK(sch::e_digits(50) ==
+        "27182818284590452353602874713526624977572470936999");
+  // the Feynman point: six 9s from the 762nd decimal place
+  CHECK(sch::pi_digits(800).substr(762, 6) == "999999");
+  const std::string pi = sch::pi_digits(3000);
+  CHECK(pi.size() == 3000);
+  CHECK(sch::pi_digits(2000) == pi.substr(0, 2000));
+  CHECK(sch::e_digits(2000) == sch::e_digits(3000).substr(0, 2000));
+  CHECK_THROWS_AS(sch::pi_digits(0), std::invalid_argument);
+}
+
+} // namespace big_int_test
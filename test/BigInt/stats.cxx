@@ -0,0 +1,103 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+
+#include "BigInt.hpp"
+
+namespace big_int_test {
+
+TEST_CASE("stats are enabled for this target") {
+  STATIC_REQUIRE(sch::STATS_ENABLED);
+}
+
+TEST_CASE("calls are counted per operation") {
+  const sch::BigInt a{std::string(100, '7')};
+  const sch::BigInt b{std::string(50, '3')};
+  sch::reset_stats();
+  const sch::BigInt sum = a + b;
+  const sch::BigInt difference = a - b;
+  const sch::BigInt product = a * b;
+  const sch::BigInt quotient = a / b;
+  const sch::BigInt remainder = a % b;
+  const std::string str = product.to_string();
+  const sch::Stats s = sch::stats();
+  CHECK(s[sch::Op::add].calls == 1);
+  CHECK(s[sch::Op::sub].calls == 1);
+  CHECK(s[sch::Op::mul].calls == 1);
+  CHECK(s[sch::Op::div].calls == 1);
+  CHECK(s[sch::Op::mod].calls == 1);
+  CHECK(s[sch::Op::to_string].calls == 1);
+  CHECK(s[sch::Op::construct].calls == 0);
+}
+
+TEST_CASE("allocation budgets") {
+  const sch::BigInt a{std::string(500, '7')};
+  const sch::BigInt b{std::string(500, '3')};
+
+  SECTION("schoolbook multiplication allocates the product only") {
+    const sch::Stats before = sch::stats();
+    const sch::BigInt product = a * b;
+    const sch::Stats s = sch::stats() - before;
+    CHECK(s[sch::Op::mul].allocations == 1);
+    CHECK(s[sch::Op::mul].bytes == product.limbs().capacity() * 8);
+    CHECK(s[sch::Op::mul].temporaries <= 2);
+  }
+  SECTION("addition allocates the sum only") {
+    const sch::Stats before = sch::stats();
+    const sch::BigInt sum = a + b;
+    const sch::Stats s = sch::stats() - before;
+    CHECK(s[sch::Op::add].allocations == 1);
+    CHECK(s[sch::Op::add].temporaries <= 2);
+  }
+  SECTION("multiplying by zero allocates at most the result") {
+    const sch::Stats before = sch::stats();
+    const sch::BigInt product = a * 0;
+    const sch::Stats s = sch::stats() - before;
+    CHECK(s[sch::Op::mul].allocations <= 1);
+  }
+  SECTION("Karatsuba allocates a few buffers per recursion node") {
+    const sch::BigInt x{std::string(20000, '7')};
+    const sch::BigInt y{std::string(20000, '3')};
+    const sch::Stats before = sch::stats();
+    const sch::BigInt product = x * y;
+    const sch::Stats s = sch::stats() - before;
+    // 1112 limbs: 3^6 = 729 nodes at most above the schoolbook threshold
+    CHECK(s[sch::Op::mul].allocations < 4 * 729);
+    CHECK(s.peak_limbs - before.live_limbs < 20 * x.limbs().size());
+  }
+}
+
+TEST_CASE("nested operations are charged to the outermost") {
+  const sch::BigInt base{987654321};
+  sch::reset_stats();
+  const sch::BigInt p = sch::pow(base, 200);
+  const sch::Stats s = sch::stats();
+  CHECK(s[sch::Op::pow].calls == 1);
+  CHECK(s[sch::Op::mul].calls > 0);
+  CHECK(s[sch::Op::mul].allocations == 0);
+  CHECK(s[sch::Op::pow].allocations > 0);
+}
+
+TEST_CASE("live limbs return to their level") {
+  const sch::Stats before = sch::stats();
+  {
+    const sch::BigInt a{std::string(3000, '9')};
+    const sch::BigInt b = a * a;
+    CHECK(sch::stats().live_limbs > before.live_limbs);
+  }
+  const sch::Stats after = sch::stats();
+  CHECK(after.live_limbs == before.live_limbs);
+  CHECK(after.peak_limbs >= before.live_limbs + 2 * 3000 / 18);
+}
+
+TEST_CASE("reset_stats") {
+  const sch::BigInt a{std::string(100, '1')};
+  const sch::BigInt b = a * a;
+  sch::reset_stats();
+  const sch::Stats s = sch::stats();
+  CHECK(s.total().calls == 0);
+  CHECK(s.total().allocations == 0);
+  CHECK(s.total().temporaries == 0);
+  CHECK(s.peak_limbs == s.live_limbs);
+}
+
+} // namespace big_int_test
@@ -0,0 +1,160 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BigInt.hpp"
+
+namespace big_int_test {
+
+/// @return the events in the default ring, which is left empty
+inline std::vector<sch::TraceEvent> drain() {
+  std::vector<sch::TraceEvent> events;
+  sch::trace_ring().drain(
+      [&events](const sch::TraceEvent &e) { events.push_back(e); });
+  return events;
+}
+
+inline std::size_t count(const std::vector<sch::TraceEvent> &events,
+                         const sch::Algo algo) {
+  std::size_t n = 0;
+  for (const auto &e : events) {
+    n += e.algo == algo ? 1 : 0;
+  }
+  return n;
+}
+
+TEST_CASE("tracing is enabled for this target") {
+  STATIC_REQUIRE(sch::TRACE_ENABLED);
+  CHECK(std::string{sch::algo_name(sch::Algo::div_newton)} == "div_newton");
+}
+
+TEST_CASE("multiplication tiers") {
+  drain();
+  const sch::BigInt small{std::string(100, '7')};
+  const sch::BigInt large{std::string(2000, '3')};
+
+  SECTION("schoolbook below the Karatsuba threshold") {
+    const sch::BigInt p = small * small + 1;
+    const sch::BigInt q = small * (small + 1);
+    const auto events = drain();
+    CHECK(count(events, sch::Algo::sqr_schoolbook) == 1);
+    REQUIRE(count(events, sch::Algo::mul_schoolbook) == 1);
+    for (const auto &e : events) {
+      if (e.algo == sch::Algo::mul_schoolbook) {
+        CHECK(e.lhs_limbs == 6);
+        CHECK(e.rhs_limbs == 6);
+        CHECK(e.depth == 0);
+      }
+    }
+  }
+  SECTION("Karatsuba above it, larger operand first") {
+    const sch::BigInt p = small * large;
+    const sch::BigInt q = large * (large + 1);
+    const sch::BigInt r = large * large;
+    const auto events = drain();
+    REQUIRE(events.size() == 3);
+    CHECK(events[0].algo == sch::Algo::mul_schoolbook); // by the short side
+    CHECK(events[0].lhs_limbs == large.limbs().size());
+    CHECK(events[0].rhs_limbs == small.limbs().size());
+    CHECK(events[1].algo == sch::Algo::mul_karatsuba);
+    CHECK(events[2].algo == sch::Algo::sqr_karatsuba);
+  }
+}
+
+TEST_CASE("division tiers and nesting") {
+  const sch::BigInt a{std::string(60000, '7')};
+  drain();
+
+  SECTION("single limb") {
+    const sch::BigInt q = a / 7;
+    const auto events = drain();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].algo == sch::Algo::div_1);
+  }
+  SECTION("Knuth") {
+    const sch::BigInt q = a / sch::BigInt{std::string(500, '3')};
+    const auto events = drain();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].algo == sch::Algo::div_knuth);
+  }
+  SECTION("Newton reports its inner calls one level down") {
+    const sch::BigInt q = a / sch::BigInt{std::string(30000, '3')};
+    const auto events = drain();
+    REQUIRE(count(events, sch::Algo::div_newton) == 1);
+    CHECK(count(events, sch::Algo::reciprocal) >= 2);
+    std::uint64_t inner = 0;
+    for (const auto &e : events) {
+      if (e.algo == sch::Algo::div_newton) {
+        CHECK(e.depth == 0);
+        // the outer call ends last
+        CHECK(&e == &events.back());
+        CHECK(e.nanoseconds >= inner);
+      } else {
+        CHECK(e.depth > 0);
+        if (e.depth == 1) {
+          inner += e.nanoseconds;
+        }
+      }
+    }
+  }
+}
+
+namespace {
+std::vector<sch::TraceEvent> seen;
+void remember(const sch::TraceEvent &e) { seen.push_back(e); }
+} // namespace
+
+TEST_CASE("custom callbacks") {
+  drain();
+  const sch::BigInt a{std::string(100, '7')};
+  const sch::TraceCallback previous = sch::set_trace_callback(&remember);
+  CHECK(previous == sch::default_trace_callback());
+  const sch::BigInt p = a * a;
+  CHECK(seen.size() == 1);
+
+  sch::set_trace_callback(nullptr);
+  const sch::BigInt q = a * a;
+  CHECK(seen.size() == 1);
+
+  sch::set_trace_callback(previous);
+  CHECK(drain().empty());
+}
+
+TEST_CASE("ring buffer") {
+  SECTION("drops when full and keeps the oldest") {
+    sch::TraceRing<8> ring;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+      CHECK(ring.push({sch::Algo::div_1, i, 0, 0, 0}) == (i < 8));
+    }
+    CHECK(ring.dropped() == 2);
+    sch::TraceEvent e{};
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      REQUIRE(ring.pop(e));
+      CHECK(e.depth == i);
+    }
+    CHECK_FALSE(ring.pop(e));
+  }
+  SECTION("concurrent producers lose nothing that fits") {
+    sch::TraceRing<1024> ring;
+    std::vector<std::thread> threads;
+    for (std::uint32_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&ring, t] {
+        for (std::uint32_t i = 0; i < 200; ++i) {
+          ring.push({sch::Algo::mul_schoolbook, t, i, 0, 0});
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    std::vector<std::size_t> per_thread(4, 0);
+    ring.drain([&per_thread](const sch::TraceEvent &e) {
+      ++per_thread[e.depth];
+    });
+    CHECK(per_thread == std::vector<std::size_t>(4, 200));
+    CHECK(ring.dropped() == 0);
+  }
+}
+
+} // namespace big_int_test